@@ -0,0 +1,79 @@
+// bench_pool.cpp - requests/second for short programs: fresh CPU per request vs CPUPool
+// Build: g++ -O2 -std=c++17 -pthread bench_pool.cpp rvsim.cpp cpu_pool.cpp rvsim_c.cpp -o bench_pool
+// Usage: bench_pool [requests] [threads]
+#include "cpu_pool.h"
+#include "rvsim.h"
+#include "rvsim_c.h"
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Small request: sum 1..16 into memory at 0x100, then HALT (about 70 instructions).
+static const uint32_t kProgram[] = {
+    0x00000093, // addi x1, x0, 0      sum
+    0x00100113, // addi x2, x0, 1      i
+    0x01100193, // addi x3, x0, 17     limit
+    0x002080b3, // loop: add x1, x1, x2
+    0x00110113, //       addi x2, x2, 1
+    0xfe311ce3, //       bne x2, x3, loop
+    0x10102023, // sw x1, 0x100(x0)
+    0x0000006f, // jal x0, 0           HALT
+};
+static const uint32_t kExpected = 136;
+
+template <class F>
+static double requests_per_sec(const char *name, size_t requests, unsigned threads, F one_request) {
+    atomic<size_t> next{0};
+    atomic<size_t> bad{0};
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+        pool.emplace_back([&]{
+            while (next++ < requests)
+                if (one_request() != kExpected) bad++;
+        });
+    for (auto &th : pool) th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    double rps = (double)requests / secs;
+    cout << left << setw(26) << name << right << fixed << setprecision(0)
+         << setw(14) << rps << " req/s" << (bad ? "  [WRONG RESULTS]" : "") << "\n";
+    return rps;
+}
+
+int main(int argc, char **argv) {
+    size_t requests = argc > 1 ? stoull(argv[1]) : 20000;
+    unsigned threads = argc > 2 ? (unsigned)stoul(argv[2]) : max(1u, thread::hardware_concurrency());
+    const size_t nwords = sizeof(kProgram) / sizeof(kProgram[0]);
+    cout << requests << " requests, " << threads << " threads, 1MB imem + 1MB dmem per CPU\n\n";
+
+    double fresh = requests_per_sec("fresh CPU per request", requests, threads, [&]{
+        CPU cpu;
+        cpu.verbose = false;
+        cpu.load_words(kProgram, nwords);
+        cpu.run();
+        return cpu.dmem.load_u32(0x100);
+    });
+
+    CPUPool cpp_pool(threads);
+    double pooled = requests_per_sec("CPUPool (C++ API)", requests, threads, [&]{
+        CPUPool::Lease cpu = cpp_pool.lease();
+        cpu->load_words(kProgram, nwords);
+        cpu->run();
+        return cpu->dmem.load_u32(0x100);
+    });
+
+    rvsim_pool *c_pool = rvsim_pool_create(threads, 1 << 20, 1 << 20);
+    requests_per_sec("rvsim_pool (C API)", requests, threads, [&]{
+        rvsim_cpu *cpu = rvsim_pool_acquire(c_pool);
+        uint32_t v = 0;
+        rvsim_load_words(cpu, kProgram, nwords);
+        rvsim_run(cpu, 1000, nullptr);
+        rvsim_read_u32(cpu, 0x100, &v);
+        rvsim_pool_release(c_pool, cpu);
+        return v;
+    });
+    rvsim_pool_destroy(c_pool);
+
+    cout << "\npool speedup: " << setprecision(1) << pooled / fresh << "x\n";
+    return 0;
+}
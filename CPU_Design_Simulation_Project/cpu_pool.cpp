@@ -0,0 +1,50 @@
+// cpu_pool.cpp - CPUPool implementation (see cpu_pool.h)
+#include "cpu_pool.h"
+
+#include <bits/stdc++.h>
+using namespace std;
+
+CPUPool::CPUPool(size_t count, size_t imem_size, size_t dmem_size) {
+    cpus.reserve(count);
+    free_list.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        cpus.push_back(make_unique<CPU>(imem_size, dmem_size));
+        cpus.back()->verbose = false;
+        cpus.back()->warn_unaligned = false;
+        free_list.push_back(cpus.back().get());
+    }
+}
+
+CPU *CPUPool::acquire() {
+    unique_lock<mutex> lk(m);
+    cv.wait(lk, [&]{ return !free_list.empty(); });
+    CPU *c = free_list.back();
+    free_list.pop_back();
+    return c;
+}
+
+CPU *CPUPool::try_acquire() {
+    lock_guard<mutex> lk(m);
+    if (free_list.empty()) return nullptr;
+    CPU *c = free_list.back();
+    free_list.pop_back();
+    return c;
+}
+
+void CPUPool::release(CPU *cpu) {
+    if (!cpu) return;
+    // Reset outside the lock: its cost is proportional to the pages the program touched.
+    cpu->reset();
+    cpu->events = nullptr;
+    cpu->trace = false;
+    {
+        lock_guard<mutex> lk(m);
+        free_list.push_back(cpu);
+    }
+    cv.notify_one();
+}
+
+size_t CPUPool::available() const {
+    lock_guard<mutex> lk(m);
+    return free_list.size();
+}
@@ -0,0 +1,57 @@
+// cpu_pool.h - thread-safe pool of preallocated CPUs
+// Constructing a CPU zero-fills its memories; a pooled CPU is built once and
+// afterwards only reset(), which clears just the pages the last program touched.
+#pragma once
+
+#include "rvsim.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class CPUPool {
+public:
+    CPUPool(size_t count, size_t imem_size = 1<<20, size_t dmem_size = 1<<20);
+
+    CPUPool(const CPUPool &) = delete;
+    CPUPool &operator=(const CPUPool &) = delete;
+
+    // Blocks until a CPU is free. The CPU is in power-on state.
+    CPU *acquire();
+    // Returns nullptr instead of blocking when the pool is empty.
+    CPU *try_acquire();
+    // Resets the CPU and hands it back. Must come from this pool.
+    void release(CPU *cpu);
+
+    size_t size() const { return cpus.size(); }
+    size_t available() const;
+
+    // RAII handle: releases the CPU when it goes out of scope.
+    class Lease {
+    public:
+        Lease(CPUPool &p, CPU *c) : pool(&p), cpu(c) {}
+        Lease(Lease &&o) noexcept : pool(o.pool), cpu(o.cpu) { o.cpu = nullptr; }
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease() { if (cpu) pool->release(cpu); }
+
+        CPU *get() const { return cpu; }
+        CPU *operator->() const { return cpu; }
+        CPU &operator*() const { return *cpu; }
+
+    private:
+        CPUPool *pool;
+        CPU *cpu;
+    };
+
+    Lease lease() { return Lease(*this, acquire()); }
+
+private:
+    std::vector<std::unique_ptr<CPU>> cpus; // owned, never reallocated after construction
+    std::vector<CPU *> free_list;
+    mutable std::mutex m;
+    std::condition_variable cv;
+};
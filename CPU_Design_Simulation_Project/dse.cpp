@@ -0,0 +1,166 @@
+// dse.cpp - cache / branch predictor / pipeline models and the parallel sweep (see dse.h)
+#include "dse.h"
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// ============================== Timing models ==============================
+// Trace-driven timing: each configuration replays the shared EventTrace and
+// accumulates cycles, cache misses and branch mispredictions on its own.
+
+struct Cache {
+    uint32_t sets = 0, ways = 0, line_shift = 0;
+    vector<uint32_t> tags;   // sets*ways
+    vector<uint64_t> stamp;  // last-use time per line, 0 = invalid
+    uint64_t tick = 0;
+
+    explicit Cache(const CacheConfig &c) {
+        if (c.size_bytes == 0) return;
+        ways = c.ways;
+        sets = c.size_bytes / (c.line_bytes * c.ways);
+        if (sets == 0 || (sets & (sets - 1))) throw runtime_error("cache sets must be a power of two");
+        while ((1u << line_shift) < c.line_bytes) line_shift++;
+        tags.assign((size_t)sets * ways, 0);
+        stamp.assign((size_t)sets * ways, 0);
+    }
+
+    // Returns true on hit; on miss the LRU way of the set is refilled.
+    bool access(uint32_t addr) {
+        if (sets == 0) return true;
+        uint32_t line = addr >> line_shift;
+        uint32_t set = line & (sets - 1);
+        size_t base = (size_t)set * ways;
+        tick++;
+        size_t victim = base;
+        for (size_t w = base; w < base + ways; w++) {
+            if (stamp[w] && tags[w] == line) { stamp[w] = tick; return true; }
+            if (stamp[w] < stamp[victim]) victim = w;
+        }
+        tags[victim] = line;
+        stamp[victim] = tick;
+        return false;
+    }
+};
+
+struct Predictor {
+    PredictorConfig cfg;
+    vector<uint8_t> counters; // 2-bit, initialized weakly not taken
+    uint32_t history = 0;
+
+    explicit Predictor(const PredictorConfig &c) : cfg(c) {
+        if (cfg.kind == BPKind::Bimodal || cfg.kind == BPKind::GShare)
+            counters.assign((size_t)1 << cfg.table_bits, 1);
+    }
+
+    // Predicts the branch, trains on the real outcome, returns true if the prediction was correct.
+    bool predict_and_update(const Event &e) {
+        switch (cfg.kind) {
+            case BPKind::NotTaken: return !e.taken;
+            case BPKind::BTFN:     return e.backward == e.taken;
+            case BPKind::Bimodal:
+            case BPKind::GShare: {
+                uint32_t mask = (1u << cfg.table_bits) - 1u;
+                uint32_t idx = e.pc >> 2;
+                if (cfg.kind == BPKind::GShare) idx ^= history & ((1u << cfg.hist_bits) - 1u);
+                uint8_t &ctr = counters[idx & mask];
+                bool pred = ctr >= 2;
+                if (e.taken && ctr < 3) ctr++;
+                if (!e.taken && ctr > 0) ctr--;
+                history = (history << 1) | (e.taken ? 1u : 0u);
+                return pred == e.taken;
+            }
+        }
+        return true; // unreachable
+    }
+};
+
+// ============================== Replay ==============================
+TimingStats simulate_timing(const EventTrace &trace, const TimingConfig &cfg) {
+    Cache ic(cfg.icache), dc(cfg.dcache);
+    Predictor bp(cfg.bp);
+    TimingStats st;
+    EventTrace::Reader rd(trace);
+    Event e;
+    while (rd.next(e)) {
+        st.insns++;
+        st.cycles++;
+        st.ic_access++;
+        if (!ic.access(e.pc)) { st.ic_miss++; st.cycles += cfg.pipe.miss_penalty; }
+        switch (e.kind) {
+            case EvKind::LOAD:
+            case EvKind::STORE:
+                st.dc_access++;
+                if (!dc.access(e.addr)) { st.dc_miss++; st.cycles += cfg.pipe.miss_penalty; }
+                break;
+            case EvKind::BRANCH:
+                st.branches++;
+                if (!bp.predict_and_update(e)) { st.mispredicts++; st.cycles += cfg.pipe.mispredict_penalty; }
+                break;
+            case EvKind::JUMP:
+                st.cycles += cfg.pipe.jump_penalty;
+                break;
+            case EvKind::ALU:
+                break;
+        }
+    }
+    return st;
+}
+
+// ============================== Design-space exploration ==============================
+vector<TimingStats> run_design_space(const EventTrace &trace, const vector<TimingConfig> &configs,
+                                     unsigned threads) {
+    vector<TimingStats> out(configs.size());
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    threads = (unsigned)min<size_t>(threads, max<size_t>(1, configs.size()));
+    atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < configs.size(); i = next++)
+            out[i] = simulate_timing(trace, configs[i]);
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto &th : pool) th.join();
+    return out;
+}
+
+vector<TimingConfig> default_design_space() {
+    struct NamedCache { const char *name; CacheConfig c; };
+    struct NamedBP { const char *name; PredictorConfig p; };
+    struct NamedPipe { const char *name; PipelineConfig p; };
+    const NamedCache icaches[] = { {"I4K-1w", {4096, 32, 1}}, {"I16K-2w", {16384, 32, 2}} };
+    const NamedCache dcaches[] = { {"D1K-1w", {1024, 32, 1}}, {"D4K-2w", {4096, 32, 2}}, {"D16K-4w", {16384, 64, 4}} };
+    const NamedBP bps[] = { {"nt", {BPKind::NotTaken, 0, 0}}, {"btfn", {BPKind::BTFN, 0, 0}},
+                            {"bimodal", {BPKind::Bimodal, 10, 0}}, {"gshare", {BPKind::GShare, 10, 8}} };
+    const NamedPipe pipes[] = { {"5st", {2, 1, 20}}, {"8st", {5, 2, 20}} };
+
+    vector<TimingConfig> v;
+    for (auto &ic : icaches)
+        for (auto &dc : dcaches)
+            for (auto &bp : bps)
+                for (auto &pp : pipes) {
+                    TimingConfig c;
+                    c.name = string(ic.name) + " " + dc.name + " " + bp.name + " " + pp.name;
+                    c.icache = ic.c; c.dcache = dc.c; c.bp = bp.p; c.pipe = pp.p;
+                    v.push_back(c);
+                }
+    return v;
+}
+
+void print_dse_table(const vector<TimingConfig> &configs, const vector<TimingStats> &stats, ostream &os) {
+    os << left << setw(32) << "config" << right
+       << setw(12) << "insns" << setw(12) << "cycles" << setw(8) << "CPI"
+       << setw(10) << "I-miss%" << setw(10) << "D-miss%" << setw(10) << "BP-miss%" << "\n";
+    os << fixed;
+    for (size_t i = 0; i < configs.size(); i++) {
+        const TimingStats &s = stats[i];
+        os << left << setw(32) << configs[i].name << right
+           << setw(12) << s.insns << setw(12) << s.cycles
+           << setw(8) << setprecision(3) << s.cpi()
+           << setw(10) << setprecision(2) << 100.0 * s.ic_miss_rate()
+           << setw(10) << 100.0 * s.dc_miss_rate()
+           << setw(10) << 100.0 * s.mispredict_rate() << "\n";
+    }
+    os.unsetf(ios::floatfield);
+    os << setprecision(6);
+}
@@ -0,0 +1,75 @@
+// dse.h - trace-driven timing models and design-space exploration
+// Timing configurations replay an EventTrace recorded by CPU::step() (see rvsim.h)
+// instead of re-running the functional core.
+#pragma once
+
+#include "rvsim.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ============================== Timing configurations ==============================
+// Set-associative cache with true LRU replacement. size_bytes == 0 means "perfect cache".
+struct CacheConfig {
+    uint32_t size_bytes = 0;
+    uint32_t line_bytes = 32;
+    uint32_t ways = 1;
+};
+
+// Conditional branch direction predictors.
+enum class BPKind {
+    NotTaken, // static: always predict not taken
+    BTFN,     // static: backward taken, forward not taken
+    Bimodal,  // 2-bit saturating counters indexed by PC
+    GShare    // 2-bit counters indexed by PC xor global history
+};
+
+struct PredictorConfig {
+    BPKind kind = BPKind::NotTaken;
+    uint32_t table_bits = 10; // log2(number of counters)
+    uint32_t hist_bits = 8;   // gshare global history length
+};
+
+// In-order pipeline cost model: CPI 1 plus stall cycles.
+struct PipelineConfig {
+    uint32_t mispredict_penalty = 2; // cycles lost on a wrong branch direction
+    uint32_t jump_penalty = 1;       // bubble for jal/jalr target resolution
+    uint32_t miss_penalty = 20;      // cycles per I- or D-cache miss
+};
+
+struct TimingConfig {
+    std::string name;
+    CacheConfig icache, dcache;
+    PredictorConfig bp;
+    PipelineConfig pipe;
+};
+
+struct TimingStats {
+    uint64_t insns = 0, cycles = 0;
+    uint64_t ic_access = 0, ic_miss = 0;
+    uint64_t dc_access = 0, dc_miss = 0;
+    uint64_t branches = 0, mispredicts = 0;
+
+    double cpi() const { return insns ? (double)cycles / (double)insns : 0.0; }
+    double ic_miss_rate() const { return ic_access ? (double)ic_miss / (double)ic_access : 0.0; }
+    double dc_miss_rate() const { return dc_access ? (double)dc_miss / (double)dc_access : 0.0; }
+    double mispredict_rate() const { return branches ? (double)mispredicts / (double)branches : 0.0; }
+};
+
+// ============================== Design-space exploration ==============================
+// Replays one trace through one configuration.
+TimingStats simulate_timing(const EventTrace &trace, const TimingConfig &cfg);
+
+// All configurations share one read-only trace; worker threads pull configurations
+// from an atomic index so long-running ones don't hold up the rest.
+// threads == 0 uses std::thread::hardware_concurrency().
+std::vector<TimingStats> run_design_space(const EventTrace &trace, const std::vector<TimingConfig> &configs,
+                                          unsigned threads = 0);
+
+// Default sweep: I-cache x D-cache x predictor x pipeline depth.
+std::vector<TimingConfig> default_design_space();
+
+// Summary table, one row per configuration.
+void print_dse_table(const std::vector<TimingConfig> &configs, const std::vector<TimingStats> &stats, std::ostream &os);
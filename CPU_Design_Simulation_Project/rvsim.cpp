@@ -0,0 +1,304 @@
+// rvsim.cpp - CPU loaders, instruction execution and run loop (see rvsim.h)
+#include "rvsim.h"
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// ============================== Loaders ==============================
+void CPU::load_hex_program(const string &path) {
+    ifstream fin(path);
+    if (!fin) throw runtime_error("Cannot open hex file: " + path);
+    load_hex_stream(fin);
+}
+
+void CPU::load_hex_string(const string &text) {
+    istringstream in(text);
+    load_hex_stream(in);
+}
+
+void CPU::load_hex_stream(istream &in) {
+    string line;
+    uint32_t addr_word = 0;
+    while (getline(in, line)) {
+        // trim spaces
+        auto trim = [](string &s){                          // trim leading/trailing spaces
+            size_t a = s.find_first_not_of(" \t\r\n");
+            size_t b = s.find_last_not_of(" \t\r\n");
+            if (a == string::npos) { s.clear(); return; }
+            s = s.substr(a, b - a + 1);
+        };
+        trim(line);
+        if (line.empty()) continue; // ignore blank lines
+        // allow lowercase or uppercase hex without 0x prefix
+        if (line.size() > 8) throw runtime_error("Invalid hex word length: " + line);
+        // left-pad to 8 chars for stoul safety
+        if (line.size() < 8) line = string(8 - line.size(), '0') + line;
+        uint32_t instr = 0;
+
+        try {
+            instr = (uint32_t)stoul(line, nullptr, 16);         
+        } catch(...) {
+            throw runtime_error("Invalid hex number: " + line);
+        }
+        imem.store_instr_word(addr_word++, instr);
+    }
+}
+
+void CPU::load_words(const uint32_t *words, size_t count) {
+    for (size_t i = 0; i < count; i++) imem.store_instr_word((uint32_t)i, words[i]);
+}
+
+// ============================== Single instruction step ==============================
+// Updates PC and state.
+bool CPU::step() {
+    uint32_t insn = fetch();
+    uint32_t opc = opcode(insn);
+    uint32_t f3 = funct3(insn);
+    uint32_t f7 = funct7(insn);
+    int r_d  = rd(insn);
+    int r1   = rs1(insn);
+    int r2   = rs2(insn);
+    uint32_t pc_next = PC + 4; // default next PC
+    Event ev;                  // filled in by the cases below, recorded on retire
+    ev.pc = PC;
+
+    // Read registers
+    auto R1 = rf.read(r1);
+    auto R2 = rf.read(r2);
+
+    // Trace printout
+    if (trace) {
+        cout << hex << setfill('0');
+        cout << "PC=0x" << setw(8) << PC << " INSN=0x" << setw(8) << insn << dec << setfill(' ');
+    }
+
+    // Instruction decode and execute
+    switch (opc) {
+        case 0x33: { // R-type
+            // funct3 selects op family; funct7 disambiguates (e.g., add/sub, srl/sra)
+            uint32_t res = 0;
+            if (f3 == 0x0) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::ADD, R1, R2); // add
+                else if (f7 == 0x20) res = alu_ops(ALUOp::SUB, R1, R2); // sub
+                else goto illegal;
+            } else if (f3 == 0x7) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::AND_, R1, R2); // and
+                else goto illegal;
+            } else if (f3 == 0x6) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::OR_, R1, R2); // or
+                else goto illegal;
+            } else if (f3 == 0x4) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::XOR_, R1, R2); // xor
+                else goto illegal;
+            } else if (f3 == 0x1) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::SLL, R1, R2); // sll
+                else goto illegal;
+            } else if (f3 == 0x5) {
+                if (f7 == 0x00)      res = alu_ops(ALUOp::SRL, R1, R2); // srl
+                else if (f7 == 0x20) res = alu_ops(ALUOp::SRA, R1, R2); // sra
+                else goto illegal;
+            } else {
+                goto illegal;
+            }
+            rf.write(r_d, res);
+            if (trace) cout << "  R-type -> x" << r_d << " = 0x" << hex << setw(8) << res << dec;
+            break;
+        }
+        case 0x13: { // I-type ALU (addi, slli/srli/srai via 0x13 too in full ISA, but we'll keep addi)
+            int32_t imm = imm_i(insn);
+            uint32_t res = 0;
+            if (f3 == 0x0) { // addi
+                res = (uint32_t)((int32_t)R1 + imm);
+            } else {
+                goto illegal; // keeping subset small
+            }
+            // Write result
+            rf.write(r_d, res);
+            if (trace) cout << "  addi -> x" << r_d << " = 0x" << hex << setw(8) << res << dec;
+            break;
+        }
+        case 0x03: { // Loads
+            // I-type
+            int32_t imm = imm_i(insn);
+            uint32_t addr = (uint32_t)((int32_t)R1 + imm);
+
+            // Warn on unaligned access
+            if (warn_unaligned && (addr & 3)) cerr << "[WARN] Unaligned LW at 0x" << hex << addr << dec << "\n";
+            
+            // Load based on funct3
+            if (f3 == 0x2) { // LW
+                ev.kind = EvKind::LOAD;
+                ev.addr = addr;
+                uint32_t val = dmem.load_u32(addr);
+                rf.write(r_d, val);
+                if (trace) cout << "  lw -> x" << r_d << " = 0x" << hex << setw(8) << val << dec;
+            } else {
+                goto illegal;
+            }
+            break;
+        }
+        case 0x23: { // Stores
+            // S-type
+            int32_t imm = imm_s(insn);
+            uint32_t addr = (uint32_t)((int32_t)R1 + imm);
+
+            // Warn on unaligned access
+            if (warn_unaligned && (addr & 3)) cerr << "[WARN] Unaligned SW at 0x" << hex << addr << dec << "\n";
+            
+            
+            // Store based on funct3
+            if (f3 == 0x2) { // SW
+                ev.kind = EvKind::STORE;
+                ev.addr = addr;
+                dmem.store_u32(addr, R2);
+                if (trace) cout << "  sw mem[0x" << hex << addr << "] = 0x" << setw(8) << R2 << dec;
+            } else {
+                goto illegal;
+            }
+            break;
+        }
+        case 0x63: { // Branches
+
+            // B-type
+            int32_t off = imm_b(insn);
+            bool take = false;
+
+            // beq, bne only for subset
+            if (f3 == 0x0) { // beq
+                take = (R1 == R2);
+            } else if (f3 == 0x1) { // bne
+                take = (R1 != R2);
+            } else {
+                goto illegal;
+            }
+            ev.kind = EvKind::BRANCH;
+            ev.taken = take;
+            ev.backward = (off < 0);
+
+            // Branch taken?
+            if (take) pc_next = (uint32_t)((int32_t)PC + off);
+
+            // Trace printout
+            if (trace) cout << (take ? "  branch TAKEN" : "  branch not taken");
+            break;
+        }
+        case 0x6F: { // JAL
+
+            // J-type
+            int32_t off = imm_j(insn);
+            uint32_t ret = PC + 4;
+
+            // Write return address
+            rf.write(r_d, ret);
+            uint32_t newPC = (uint32_t)((int32_t)PC + off);
+            ev.kind = EvKind::JUMP;
+            ev.taken = true;
+            ev.backward = (off < 0);
+
+            // HALT detection: jal x0, 0
+            if (r_d == 0 && off == 0) {
+                // Convention: jal x0, 0 => HALT
+                if (trace) cout << "  HALT";
+                PC = pc_next; // or PC stays? We'll stop after this step anyway
+                if (events) events->record(ev);
+                if (trace) cout << "\n";
+                stop = StopReason::Halt;
+                return false;
+            }
+            pc_next = newPC;
+
+            // Trace printout
+            if (trace) cout << "  jal -> x" << r_d << "=0x" << hex << setw(8) << ret
+                             << " PC=0x" << setw(8) << pc_next << dec;
+            break;
+        }
+        case 0x67: { // JALR
+
+            // I-type
+            int32_t off = imm_i(insn);
+            uint32_t ret = PC + 4;
+            uint32_t target = (uint32_t)((int32_t)R1 + off);        // target address
+            target &= ~1u; // spec: clear LSB
+
+            // Write return address
+            rf.write(r_d, ret);
+            pc_next = target;
+            ev.kind = EvKind::JUMP;
+            ev.taken = true;
+            ev.backward = (target < PC);
+
+            // Trace printout   
+            if (trace) cout << "  jalr -> x" << r_d << "=0x" << hex << setw(8) << ret
+                             << " PC=0x" << setw(8) << pc_next << dec;
+            break;
+        }
+        case 0x37: { // LUI
+
+            // U-type
+            int32_t imm = imm_u(insn);
+            rf.write(r_d, (uint32_t)imm);
+
+            // Trace printout
+            if (trace) cout << "  lui -> x" << r_d << " = 0x" << hex << setw(8) << (uint32_t)imm << dec;
+            break;
+        }
+        case 0x17: { // AUIPC
+
+            // U-type
+            int32_t imm = imm_u(insn);
+            uint32_t res = PC + (uint32_t)imm;
+            rf.write(r_d, res);     // write result
+
+            // Trace printout
+            if (trace) cout << "  auipc -> x" << r_d << " = 0x" << hex << setw(8) << res << dec;
+            break;
+        }
+        default:
+            goto illegal;
+    }
+
+    // Finish trace line
+    if (trace) cout << "\n";
+    if (events) events->record(ev);
+    PC = pc_next;
+    return true;
+
+    // =================== Illegal instruction handler ===================
+illegal:
+    if (verbose)
+        cerr << "[ERROR] Illegal or unsupported instruction at PC=0x" << hex << PC
+             << ", INSN=0x" << setw(8) << insn << dec << "\n";
+    stop = StopReason::Illegal;
+    // For a student project, we can stop on illegal insn to avoid infinite loops.
+    return false;
+}
+
+// ============================== Run loop ==============================
+uint64_t CPU::run(uint64_t max_steps) {
+    uint64_t steps = 0;
+    stop = StopReason::None;
+    while (steps < max_steps) {
+        bool cont = step();
+        steps++;
+        if (!cont) break;
+    }
+    if (stop == StopReason::None) {
+        stop = StopReason::MaxSteps;
+        if (verbose) cerr << "[WARN] Max steps reached; stopping to avoid hang.\n";
+    }
+    return steps;
+}
+
+// ============================== Utility: dump memory window ==============================
+// Dumps 'words' 32-bit words starting from 'addr' in memory 'm' to output stream 'os'.
+void dump_mem_words(const Mem &m, uint32_t addr, size_t words, ostream &os) {
+    os << hex << setfill('0');
+    for (size_t i = 0; i < words; i++) {
+        uint32_t a = addr + (uint32_t)(i*4);
+        if (!m.in_range(a, 4)) break;
+        uint32_t w = m.load_u32(a);
+        os << "[0x" << setw(8) << a << "] = 0x" << setw(8) << w << "\n";
+    }
+    os << dec << setfill(' ');
+}
+
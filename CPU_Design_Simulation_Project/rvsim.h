@@ -0,0 +1,374 @@
+// rvsim.h - embeddable RV32I subset simulator (C++ API)
+// The C API for non-C++ callers is in rvsim_c.h, the CPU pool in cpu_pool.h.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iosfwd>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ============================== Small helper macros ==============================
+// Extract bits from a 32-bit word
+static inline uint32_t get_bits(uint32_t x, int hi, int lo) {
+    // inclusive [hi:lo], 0-based from LSB
+    uint32_t width = (uint32_t)(hi - lo + 1);
+    uint32_t mask = (width >= 32) ? 0xFFFFFFFFu : ((1u << width) - 1u);
+    return (x >> lo) & mask;
+}
+
+// Converts a smaller signed number (like 12-bit immediate) into a 32-bit signed value.
+static inline int32_t sign_extend(uint32_t val, int from_bits) {
+    // Extend 'from_bits'-wide signed value to 32-bit signed
+    uint32_t sign_bit = 1u << (from_bits - 1);
+    uint32_t mask = (from_bits >= 32) ? 0xFFFFFFFFu : ((1u << from_bits) - 1u);
+    uint32_t v = val & mask;
+    if (v & sign_bit) {
+        // negative
+        uint32_t ext_mask = ~mask;
+        v |= ext_mask;
+    }
+    return (int32_t)v;
+}
+
+// ============================== Memory model ==============================
+// Simple byte-addressable memory with load/store operations
+// Constructor: creates a memory of given siz
+struct Mem {
+    static constexpr uint32_t PAGE_SHIFT = 12; // 4 KB granularity for dirty tracking
+
+    std::vector<uint8_t> bytes;         // memory bytes
+    std::vector<uint8_t> page_dirty;    // 1 if the page was stored to since the last clear()
+    std::vector<uint32_t> dirty_pages;  // indices of dirty pages, so clear() is O(touched)
+
+    explicit Mem(size_t size_bytes)
+        : bytes(size_bytes, 0), page_dirty((size_bytes >> PAGE_SHIFT) + 1, 0) {}
+
+    // Checks whether a read/write is inside memory bounds.
+    bool in_range(uint32_t addr, size_t len = 1) const {
+        if ((uint64_t)addr + len > bytes.size()) return false;
+        return true;
+    }
+
+    // Little-endian 32-bit load/store
+    // addr must be within range
+    uint32_t load_u32(uint32_t addr) const {
+        if (!in_range(addr, 4)) throw std::runtime_error("Data load out of range");
+        return (uint32_t)bytes[addr] |
+               ((uint32_t)bytes[addr+1] << 8) |     
+               ((uint32_t)bytes[addr+2] << 16) |        
+               ((uint32_t)bytes[addr+3] << 24);
+    }
+
+    void store_u32(uint32_t addr, uint32_t v) {
+        if (!in_range(addr, 4)) throw std::runtime_error("Data store out of range");
+        bytes[addr]   = (uint8_t)(v & 0xFF);
+        bytes[addr+1] = (uint8_t)((v >> 8) & 0xFF);
+        bytes[addr+2] = (uint8_t)((v >> 16) & 0xFF);
+        bytes[addr+3] = (uint8_t)((v >> 24) & 0xFF);
+        mark_dirty(addr);
+        mark_dirty(addr + 3);
+    }
+
+    // For instruction memory, instructions are word-addressed at word boundaries.
+    void store_instr_word(uint32_t word_index, uint32_t instr) {
+        uint32_t addr = word_index * 4;
+        store_u32(addr, instr);
+    }
+
+    // Zero every page written through store_u32() since the last clear().
+    // Writes made directly into 'bytes' are not tracked.
+    void clear() {
+        for (uint32_t p : dirty_pages) {
+            size_t lo = (size_t)p << PAGE_SHIFT;
+            size_t hi = std::min(bytes.size(), lo + ((size_t)1 << PAGE_SHIFT));
+            std::memset(bytes.data() + lo, 0, hi - lo);
+            page_dirty[p] = 0;
+        }
+        dirty_pages.clear();
+    }
+
+private:
+    void mark_dirty(uint32_t addr) {
+        uint32_t p = addr >> PAGE_SHIFT;
+        if (!page_dirty[p]) { page_dirty[p] = 1; dirty_pages.push_back(p); }
+    }
+};
+
+// ============================== Register File ==============================
+// 32 general-purpose integer registers x0..x31 (x0 is hardwired to zero)
+
+// 32 registers, initialized to zero.
+struct RegFile {
+    uint32_t x[32]{}; // zero-initialized
+
+    RegFile() { std::memset(x, 0, sizeof(x)); }
+
+    // ===== Read/write with index checks =====
+    uint32_t read(int idx) const {
+        if (idx < 0 || idx > 31) throw std::runtime_error("bad reg index");
+        return x[idx];
+    }
+
+    void write(int idx, uint32_t val) {
+        if (idx < 0 || idx > 31) throw std::runtime_error("bad reg index");
+        if (idx == 0) return; // x0 hardwired to 0
+        x[idx] = val;
+    }
+
+
+    // ===== Debug dump of all registers =====
+    void dump(std::ostream &os) const {
+        os << std::hex << std::setfill('0');
+        for (int i = 0; i < 32; i++) {
+            os << "x" << std::dec << std::setw(2) << i << ": 0x" << std::hex << std::setw(8) << x[i];
+            if (i % 4 == 3) os << "\n"; else os << "\t";
+        }
+        os << std::dec << std::setfill(' ');
+    }
+};
+
+// ============================== ALU ==============================
+// ALU with the operations needed for subset.
+enum class ALUOp {
+    ADD,
+    SUB,
+    AND_,
+    OR_,
+    XOR_,
+    SLL,
+    SRL,
+    SRA
+};
+
+// Execute ALU operation
+static inline uint32_t alu_ops(ALUOp op, uint32_t a, uint32_t b) {
+    switch (op) {
+        case ALUOp::ADD:  return a + b;
+        case ALUOp::SUB:  return a - b;
+        case ALUOp::AND_: return a & b;
+        case ALUOp::OR_:  return a | b;
+        case ALUOp::XOR_: return a ^ b;
+        case ALUOp::SLL:  return a << (b & 0x1F);
+        case ALUOp::SRL:  return a >> (b & 0x1F);
+        case ALUOp::SRA:  return (uint32_t)(((int32_t)a) >> (b & 0x1F));
+    }
+    return 0; // unreachable
+}
+
+// ============================== Event trace ==============================
+// Compact record of what the functional core did: one event per retired instruction.
+// Timing models replay this stream instead of re-running CPU::step().
+enum class EvKind : uint8_t {
+    ALU,    // anything without a memory access or control transfer
+    LOAD,
+    STORE,
+    BRANCH, // conditional branch (taken or not)
+    JUMP    // jal / jalr
+};
+
+struct Event {
+    EvKind kind = EvKind::ALU;
+    bool taken = false;     // branches: outcome, jumps: always true
+    bool backward = false;  // branches: target below PC (used by BTFN predictors)
+    uint32_t pc = 0;
+    uint32_t addr = 0;      // loads/stores: effective address
+};
+
+// Encoding, one record per event:
+//   header byte: bits[2:0]=kind, bit3=taken, bit4=backward, bit5=PC not sequential
+//   [zigzag varint of PC delta]    only if bit5 is set
+//   [zigzag varint of addr delta]  only for LOAD/STORE (delta to previous memory address)
+// Straight-line code therefore costs one byte per instruction.
+struct EventTrace {
+    std::vector<uint8_t> bytes;
+    uint64_t count = 0;
+
+    void record(const Event &e) {
+        uint8_t hdr = (uint8_t)e.kind;
+        if (e.taken) hdr |= 0x08;
+        if (e.backward) hdr |= 0x10;
+        bool seq = (e.pc == last_pc + 4);
+        if (!seq) hdr |= 0x20;
+        bytes.push_back(hdr);
+        if (!seq) put_varint(zigzag(e.pc - last_pc));
+        if (e.kind == EvKind::LOAD || e.kind == EvKind::STORE) {
+            put_varint(zigzag(e.addr - last_addr));
+            last_addr = e.addr;
+        }
+        last_pc = e.pc;
+        count++;
+    }
+
+    // Sequential decoder; many readers may walk the same (immutable) trace at once.
+    struct Reader {
+        const EventTrace &t;
+        size_t pos = 0;
+        uint32_t last_pc = 0xFFFFFFFCu;
+        uint32_t last_addr = 0;
+
+        explicit Reader(const EventTrace &trace) : t(trace) {}
+
+        bool next(Event &e) {
+            if (pos >= t.bytes.size()) return false;
+            uint8_t hdr = t.bytes[pos++];
+            e.kind = (EvKind)(hdr & 0x07);
+            e.taken = (hdr & 0x08) != 0;
+            e.backward = (hdr & 0x10) != 0;
+            e.pc = (hdr & 0x20) ? last_pc + unzigzag(get_varint()) : last_pc + 4;
+            if (e.kind == EvKind::LOAD || e.kind == EvKind::STORE) {
+                last_addr += unzigzag(get_varint());
+                e.addr = last_addr;
+            } else {
+                e.addr = 0;
+            }
+            last_pc = e.pc;
+            return true;
+        }
+
+    private:
+        uint32_t get_varint() {
+            uint32_t v = 0;
+            for (int shift = 0; pos < t.bytes.size(); shift += 7) {
+                uint8_t b = t.bytes[pos++];
+                v |= (uint32_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) break;
+            }
+            return v;
+        }
+    };
+
+private:
+    uint32_t last_pc = 0xFFFFFFFCu; // so that the first instruction at PC=0 is "sequential"
+    uint32_t last_addr = 0;
+
+    static inline uint32_t zigzag(uint32_t delta) {
+        int32_t d = (int32_t)delta;
+        return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+    }
+    static inline uint32_t unzigzag(uint32_t v) {
+        return (v >> 1) ^ (0u - (v & 1u));
+    }
+    void put_varint(uint32_t v) {
+        while (v >= 0x80) {
+            bytes.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        bytes.push_back((uint8_t)v);
+    }
+};
+
+// ============================== CPU ==============================
+
+// Why the last run()/step() stopped.
+enum class StopReason {
+    None,     // still running (or never started)
+    Halt,     // jal x0, 0
+    Illegal,  // illegal or unsupported instruction
+    MaxSteps  // run() step budget exhausted
+};
+
+// Simple RISC-V CPU simulator with integer registers and memory
+struct CPU {
+    // memories
+    Mem imem; // instruction memory
+    Mem dmem; // data memory
+
+    // state
+    uint32_t PC = 0; // program counter in bytes
+    RegFile rf;
+    StopReason stop = StopReason::None;
+
+    // config flags
+    bool trace = false;    // print per-instruction trace
+    bool warn_unaligned = true; // warn on unaligned accesses
+    bool verbose = true;   // report illegal instructions / step budget on stderr
+    EventTrace *events = nullptr; // when set, every retired instruction is appended here
+
+    // constructor
+    explicit CPU(size_t imem_size = 1<<20, size_t dmem_size = 1<<20) // 1MB each by default
+        : imem(imem_size), dmem(dmem_size) {}
+
+    // =================== Program loaders ===================
+    // Hex format: one 32-bit word (up to 8 hex digits, no 0x) per line. Blank lines allowed.
+    void load_hex_program(const std::string &path);
+    void load_hex_stream(std::istream &in);
+    void load_hex_string(const std::string &text);
+    // Raw instruction words, placed at address 0 onwards.
+    void load_words(const uint32_t *words, size_t count);
+
+    // Back to power-on state: PC=0, registers zero, and only the memory pages
+    // that were written since the last reset are cleared.
+    void reset() {
+        imem.clear();
+        dmem.clear();
+        rf = RegFile();
+        PC = 0;
+        stop = StopReason::None;
+    }
+
+    // =================== Fetch/Decode helpers ===================
+    // Fetch instruction at PC
+    uint32_t fetch() {
+        return imem.load_u32(PC);
+    }
+
+    // Field extractors
+    // rd: bits[11:7], rs1: bits[19:15], rs2: bits[24:20]
+    static inline int rd(uint32_t insn)   { return (int)get_bits(insn, 11, 7); }
+    static inline int rs1(uint32_t insn)  { return (int)get_bits(insn, 19, 15); }
+    static inline int rs2(uint32_t insn)  { return (int)get_bits(insn, 24, 20); }
+    static inline uint32_t funct3(uint32_t insn){ return get_bits(insn, 14, 12); }
+    static inline uint32_t funct7(uint32_t insn){ return get_bits(insn, 31, 25); }
+    static inline uint32_t opcode(uint32_t insn){ return get_bits(insn, 6, 0); }
+
+    // Immediate builders (sign-extended)
+    // I-type, S-type, B-type, U-type, J-type
+    static inline int32_t imm_i(uint32_t insn) { // 12-bit
+        return sign_extend(get_bits(insn, 31, 20), 12);
+    }
+
+    // I-type
+    static inline int32_t imm_s(uint32_t insn) { // 12-bit (store)
+        uint32_t v = (get_bits(insn, 31, 25) << 5) | get_bits(insn, 11, 7);
+        return sign_extend(v, 12);
+    }
+
+    // B-type
+    static inline int32_t imm_b(uint32_t insn) { // 13-bit with 0 LSB
+        uint32_t b12 = get_bits(insn, 31, 31);
+        uint32_t b10_5 = get_bits(insn, 30, 25);
+        uint32_t b4_1 = get_bits(insn, 11, 8);
+        uint32_t b11 = get_bits(insn, 7, 7);
+        uint32_t v = (b12 << 12) | (b11 << 11) | (b10_5 << 5) | (b4_1 << 1);
+        return sign_extend(v, 13);
+    }
+
+    // U-type
+    static inline int32_t imm_u(uint32_t insn) { // upper 20 bits, lower 12 are zeros
+        return (int32_t)(insn & 0xFFFFF000u);
+    }
+
+    // J-type
+    static inline int32_t imm_j(uint32_t insn) { // 21-bit with 0 LSB
+        uint32_t b20 = get_bits(insn, 31, 31);
+        uint32_t b10_1 = get_bits(insn, 30, 21);
+        uint32_t b11 = get_bits(insn, 20, 20);
+        uint32_t b19_12 = get_bits(insn, 19, 12);
+        uint32_t v = (b20 << 20) | (b19_12 << 12) | (b11 << 11) | (b10_1 << 1);
+        return sign_extend(v, 21);
+    }
+
+    // =================== Execution ===================
+    // Returns false if HALT or an illegal instruction was hit (see 'stop'), true otherwise.
+    bool step();
+    // Runs until stop or max_steps; returns the number of steps executed.
+    uint64_t run(uint64_t max_steps = 5'000'000);
+};
+
+// Dumps 'words' 32-bit words starting from 'addr' in memory 'm' to output stream 'os'.
+void dump_mem_words(const Mem &m, uint32_t addr, size_t words, std::ostream &os);
@@ -0,0 +1,165 @@
+// rvsim_c.cpp - C API wrapper over CPU / CPUPool (see rvsim_c.h)
+// No C++ exception crosses this boundary; failures are reported as RVSIM_ERROR.
+#include "rvsim_c.h"
+#include "cpu_pool.h"
+#include "rvsim.h"
+
+#include <bits/stdc++.h>
+using namespace std;
+
+struct rvsim_cpu {
+    CPU *cpu = nullptr;
+    unique_ptr<CPU> owned; // null for pooled CPUs
+    string last_error;
+};
+
+struct rvsim_pool {
+    CPUPool pool;
+    vector<unique_ptr<rvsim_cpu>> handles;       // one per pooled CPU
+    unordered_map<CPU *, rvsim_cpu *> by_cpu;    // read-only after construction
+
+    rvsim_pool(size_t count, size_t imem, size_t dmem) : pool(count, imem, dmem) {
+        vector<CPU *> all;
+        while (CPU *c = pool.try_acquire()) all.push_back(c);
+        for (CPU *c : all) {
+            handles.push_back(make_unique<rvsim_cpu>());
+            handles.back()->cpu = c;
+            by_cpu[c] = handles.back().get();
+            pool.release(c);
+        }
+    }
+};
+
+// Runs f(), turning any exception into RVSIM_ERROR with the message kept on the handle.
+template <class F>
+static int guarded(rvsim_cpu *h, F f) {
+    if (!h) return RVSIM_ERROR;
+    try {
+        return f();
+    } catch (const exception &e) {
+        h->last_error = e.what();
+    } catch (...) {
+        h->last_error = "unknown error";
+    }
+    return RVSIM_ERROR;
+}
+
+// ---- create / destroy ----
+rvsim_cpu *rvsim_create(size_t imem_bytes, size_t dmem_bytes) {
+    try {
+        auto h = make_unique<rvsim_cpu>();
+        h->owned = make_unique<CPU>(imem_bytes, dmem_bytes);
+        h->cpu = h->owned.get();
+        h->cpu->verbose = false;
+        h->cpu->warn_unaligned = false;
+        return h.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void rvsim_destroy(rvsim_cpu *cpu) {
+    if (cpu && cpu->owned) delete cpu;
+}
+
+// ---- load ----
+int rvsim_load_hex_file(rvsim_cpu *cpu, const char *path) {
+    return guarded(cpu, [&]{ cpu->cpu->load_hex_program(path ? path : ""); return RVSIM_OK; });
+}
+
+int rvsim_load_hex_string(rvsim_cpu *cpu, const char *text) {
+    return guarded(cpu, [&]{ cpu->cpu->load_hex_string(text ? text : ""); return RVSIM_OK; });
+}
+
+int rvsim_load_words(rvsim_cpu *cpu, const uint32_t *words, size_t count) {
+    return guarded(cpu, [&]{
+        if (!words && count) throw runtime_error("null instruction buffer");
+        cpu->cpu->load_words(words, count);
+        return RVSIM_OK;
+    });
+}
+
+// ---- run ----
+int rvsim_run(rvsim_cpu *cpu, uint64_t max_steps, uint64_t *steps_out) {
+    return guarded(cpu, [&]{
+        uint64_t steps = cpu->cpu->run(max_steps);
+        if (steps_out) *steps_out = steps;
+        switch (cpu->cpu->stop) {
+            case StopReason::Halt:     return (int)RVSIM_STOP_HALT;
+            case StopReason::Illegal:  return (int)RVSIM_STOP_ILLEGAL;
+            case StopReason::MaxSteps: return (int)RVSIM_STOP_MAX_STEPS;
+            case StopReason::None:     break;
+        }
+        return (int)RVSIM_STOP_NONE;
+    });
+}
+
+// ---- inspect / poke ----
+uint32_t rvsim_get_pc(const rvsim_cpu *cpu) {
+    return cpu ? cpu->cpu->PC : 0;
+}
+
+int rvsim_get_reg(const rvsim_cpu *cpu, int idx, uint32_t *value_out) {
+    return guarded(const_cast<rvsim_cpu *>(cpu), [&]{
+        uint32_t v = cpu->cpu->rf.read(idx);
+        if (value_out) *value_out = v;
+        return RVSIM_OK;
+    });
+}
+
+int rvsim_set_reg(rvsim_cpu *cpu, int idx, uint32_t value) {
+    return guarded(cpu, [&]{ cpu->cpu->rf.write(idx, value); return RVSIM_OK; });
+}
+
+int rvsim_read_u32(const rvsim_cpu *cpu, uint32_t addr, uint32_t *value_out) {
+    return guarded(const_cast<rvsim_cpu *>(cpu), [&]{
+        uint32_t v = cpu->cpu->dmem.load_u32(addr);
+        if (value_out) *value_out = v;
+        return RVSIM_OK;
+    });
+}
+
+int rvsim_write_u32(rvsim_cpu *cpu, uint32_t addr, uint32_t value) {
+    return guarded(cpu, [&]{ cpu->cpu->dmem.store_u32(addr, value); return RVSIM_OK; });
+}
+
+const char *rvsim_last_error(const rvsim_cpu *cpu) {
+    return cpu ? cpu->last_error.c_str() : "null cpu";
+}
+
+// ---- reset ----
+void rvsim_reset(rvsim_cpu *cpu) {
+    if (!cpu) return;
+    cpu->cpu->reset();
+    cpu->last_error.clear();
+}
+
+// ---- pool ----
+rvsim_pool *rvsim_pool_create(size_t count, size_t imem_bytes, size_t dmem_bytes) {
+    try {
+        return new rvsim_pool(count, imem_bytes, dmem_bytes);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void rvsim_pool_destroy(rvsim_pool *pool) {
+    delete pool;
+}
+
+rvsim_cpu *rvsim_pool_acquire(rvsim_pool *pool) {
+    if (!pool || pool->pool.size() == 0) return nullptr;
+    return pool->by_cpu.at(pool->pool.acquire());
+}
+
+rvsim_cpu *rvsim_pool_try_acquire(rvsim_pool *pool) {
+    if (!pool) return nullptr;
+    CPU *c = pool->pool.try_acquire();
+    return c ? pool->by_cpu.at(c) : nullptr;
+}
+
+void rvsim_pool_release(rvsim_pool *pool, rvsim_cpu *cpu) {
+    if (!pool || !cpu) return;
+    cpu->last_error.clear();
+    pool->pool.release(cpu->cpu);
+}
@@ -0,0 +1,70 @@
+/* rvsim_c.h - stable C API for the RV32I subset simulator
+ *
+ * Lifecycle: create (or take from a pool) -> load -> run -> inspect -> reset/destroy.
+ * Functions returning int use RVSIM_OK (0) for success and RVSIM_ERROR (-1) on
+ * failure; rvsim_last_error() then describes what went wrong on that CPU.
+ * A single rvsim_cpu must not be used from two threads at once; pools are thread-safe.
+ */
+#ifndef RVSIM_C_H
+#define RVSIM_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rvsim_cpu rvsim_cpu;
+typedef struct rvsim_pool rvsim_pool;
+
+enum {
+    RVSIM_OK = 0,
+    RVSIM_ERROR = -1
+};
+
+/* Why rvsim_run() stopped. */
+enum {
+    RVSIM_STOP_NONE = 0,
+    RVSIM_STOP_HALT = 1,      /* jal x0, 0 */
+    RVSIM_STOP_ILLEGAL = 2,   /* illegal or unsupported instruction */
+    RVSIM_STOP_MAX_STEPS = 3  /* step budget exhausted */
+};
+
+/* ---- create / destroy ---- */
+rvsim_cpu *rvsim_create(size_t imem_bytes, size_t dmem_bytes); /* NULL on allocation failure */
+void rvsim_destroy(rvsim_cpu *cpu);                             /* not for pooled CPUs */
+
+/* ---- load (instructions start at address 0) ---- */
+int rvsim_load_hex_file(rvsim_cpu *cpu, const char *path);
+int rvsim_load_hex_string(rvsim_cpu *cpu, const char *text);
+int rvsim_load_words(rvsim_cpu *cpu, const uint32_t *words, size_t count);
+
+/* ---- run ----
+ * Returns an RVSIM_STOP_* code, or RVSIM_ERROR (e.g. memory access out of range).
+ * steps_out (optional) receives the number of executed steps. */
+int rvsim_run(rvsim_cpu *cpu, uint64_t max_steps, uint64_t *steps_out);
+
+/* ---- inspect / poke ---- */
+uint32_t rvsim_get_pc(const rvsim_cpu *cpu);
+int rvsim_get_reg(const rvsim_cpu *cpu, int idx, uint32_t *value_out);
+int rvsim_set_reg(rvsim_cpu *cpu, int idx, uint32_t value);
+int rvsim_read_u32(const rvsim_cpu *cpu, uint32_t addr, uint32_t *value_out);
+int rvsim_write_u32(rvsim_cpu *cpu, uint32_t addr, uint32_t value);
+const char *rvsim_last_error(const rvsim_cpu *cpu);
+
+/* ---- reset: PC, registers, and only the memory pages written since the last reset ---- */
+void rvsim_reset(rvsim_cpu *cpu);
+
+/* ---- pool of preallocated CPUs ---- */
+rvsim_pool *rvsim_pool_create(size_t count, size_t imem_bytes, size_t dmem_bytes);
+void rvsim_pool_destroy(rvsim_pool *pool);           /* all CPUs must have been released */
+rvsim_cpu *rvsim_pool_acquire(rvsim_pool *pool);     /* blocks until a CPU is free */
+rvsim_cpu *rvsim_pool_try_acquire(rvsim_pool *pool); /* NULL if none is free */
+void rvsim_pool_release(rvsim_pool *pool, rvsim_cpu *cpu); /* resets the CPU */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RVSIM_C_H */
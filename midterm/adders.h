@@ -0,0 +1,388 @@
+// adders.h - the adder family every arithmetic unit funnels through
+// RippleCarry is the original fullAdder chain (addBits). The others compute the same
+// sums with different carry networks and are picked per unit at compile time
+// (see the *_ADDER macros in numeric_ops.h). Each one reports its modeled cost.
+#pragma once
+
+#include "bits.h"
+
+#include <cassert>
+#include <cstdint>
+
+// ============================= Section 1a: Adders (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---- 1-bit full adder ----
+// T = int evaluates one adder; T = uint64_t evaluates 64 independent adders, one per wire.
+template <class T>
+constexpr void fullAdder(T a,T b,T cin,T &sum,T &cout){
+    T axb = a ^ b;
+    sum = axb ^ cin;
+    cout = (a & b) | (a & cin) | (b & cin);
+}
+
+// ---- ripple-carry add (unsigned) ----
+// Every position is the same fullAdder with carry-in = carry-out of the position below.
+// All N adders are evaluated at once and the carries re-fed until the chain settles,
+// which is the ripple-carry circuit's steady state (at most N+1 passes, ~log2 N typical).
+template <int N>
+inline void addBits(const Bits<N>& A,const Bits<N>& B,Bits<N>& R,int &carryOut){
+    Bits<N> c, k, s, next;                    // carry-in, carry-out, sum per position
+    for(;;){
+        for(int j=0;j<Bits<N>::W;++j) fullAdder(A.w[j],B.w[j],c.w[j],s.w[j],k.w[j]);
+        wireShiftUp(k,1,next);                // carry-out of p feeds carry-in of p+1
+        if(sameBits(next,c)) break;
+        c = next;
+    }
+    carryOut = k.get(N-1);
+    R = s;
+}
+
+// ---- slice tables (4- and 8-bit adder / comparator slices) ----
+// Truth tables filled at compile time: the 4-bit ones by running fullAdder on single wires
+// over every input pattern, the 8-bit ones by chaining two 4-bit slices. A lookup is the
+// slice circuit evaluated once; splitting a pattern into wires and back is wiring.
+struct SliceAdd { uint8_t sum, cout; };
+struct SliceCmp { uint8_t lt, eq; };        // a < b (no carry out of a + ~b + 1), a == b
+
+template <int K>
+struct SliceTable {
+    static constexpr int kRows = 1 << K;
+    SliceAdd add[2][kRows][kRows];          // [cin][b][a]
+    SliceCmp cmp[kRows][kRows];             // [b][a]
+};
+
+constexpr SliceTable<4> makeSlice4() {
+    SliceTable<4> t{};
+    for (int a = 0; a < 16; ++a)
+        for (int b = 0; b < 16; ++b) {
+            for (int cin = 0; cin < 2; ++cin) {
+                int c = cin, sum = 0;
+                for (int i = 0; i < 4; ++i) {
+                    int s = 0, k = 0;
+                    fullAdder((a >> i) & 1, (b >> i) & 1, c, s, k);
+                    sum |= s << i; c = k;
+                }
+                t.add[cin][b][a] = { (uint8_t)sum, (uint8_t)c };
+            }
+            int c = 1, diff = 0;
+            for (int i = 0; i < 4; ++i) {
+                int s = 0, k = 0;
+                fullAdder((a >> i) & 1, ((b >> i) & 1) ^ 1, c, s, k);
+                c = k; diff |= ((a >> i) ^ (b >> i)) & 1;
+            }
+            t.cmp[b][a] = { (uint8_t)(c ^ 1), (uint8_t)(diff ^ 1) };
+        }
+    return t;
+}
+inline constexpr SliceTable<4> kSlice4 = makeSlice4();
+
+// low nibble slice carries into the high one; the high nibble decides a compare unless equal
+constexpr SliceTable<8> makeSlice8() {
+    SliceTable<8> t{};
+    for (int a = 0; a < 256; ++a)
+        for (int b = 0; b < 256; ++b) {
+            for (int cin = 0; cin < 2; ++cin) {
+                SliceAdd lo = kSlice4.add[cin][b & 15][a & 15], hi = kSlice4.add[lo.cout][b >> 4][a >> 4];
+                t.add[cin][b][a] = { (uint8_t)(lo.sum | hi.sum << 4), hi.cout };
+            }
+            SliceCmp lo = kSlice4.cmp[b & 15][a & 15], hi = kSlice4.cmp[b >> 4][a >> 4];
+            t.cmp[b][a] = { hi.eq ? lo.lt : hi.lt, (uint8_t)(hi.eq & lo.eq) };
+        }
+    return t;
+}
+inline constexpr SliceTable<8> kSlice8 = makeSlice8();
+
+// slice k's carry-out; wires above N are 0, so a partial top slice's carry-out
+// lands on its sum wire N % 8
+template <int N>
+inline int sliceCarry(const SliceAdd& e, int k) {
+    return (N % 8 && k == (N + 7) / 8 - 1) ? (e.sum >> (N % 8)) & 1 : e.cout;
+}
+
+// The same ripple chain one byte of wires per lookup.
+template <int N>
+inline void addSlices(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) {
+    Bits<N> r;
+    int c = 0;
+    for (int k = 0; k < (N + 7) / 8; ++k) {
+        const SliceAdd& e = kSlice8.add[c][busByte(B, k)][busByte(A, k)];
+        placeByte(r, k, e.sum);
+        c = sliceCarry<N>(e, k);
+    }
+    trimTop(r);
+    carryOut = c;
+    R = r;
+}
+
+// ---------------- Cost model ----------------
+// Counts 2-input gates (AND/OR/XOR; inverters are free) and logic depth in gate levels
+// from the operand inputs to the slowest sum/carry-out wire.
+struct AdderCost { int gates; int depth; };
+
+// ---------------- Generate/propagate prefix networks ----------------
+// g = a&b, p = a^b per bit; a network of cells then builds group (G,P) so that
+// G[i] is the carry out of bit i; sum = p ^ (G routed up one wire).
+// A cell at position i with distance d does G[i] |= P[i] & G[i-d] and P[i] &= P[i-d].
+// A cell whose group already reaches bit 0 needs no P ("gray": 2 gates, else 3).
+// S is the step capacity; each adder sizes it from N with its own steps<N>().
+
+// distances 1, 2, 4, ... below n: the levels of a log-depth network
+constexpr int prefixLevels(int n) { int k = 0; for (int d = 1; d < n; d += d) ++k; return k; }
+
+template <int N, int S>
+struct PrefixSchedule {
+    int steps = 0;
+    int dist[S > 0 ? S : 1];
+    Bits<N> cells[S > 0 ? S : 1];     // positions that have a cell in this step
+
+    void add(int d, const Bits<N>& m) { assert(steps < S); dist[steps] = d; cells[steps] = m; steps++; }
+};
+
+// Run a schedule on (G,P) in place, one word-parallel step at a time.
+template <int N, int S>
+inline void runPrefix(const PrefixSchedule<N, S>& s, Bits<N>& G, Bits<N>& P) {
+    for (int t = 0; t < s.steps; ++t) {
+        const int q = s.dist[t] / 64, r = s.dist[t] % 64;
+        const Bits<N>& m = s.cells[t];
+        // same routing as wireShiftUp, inlined; top word first so lower words still hold this step's inputs
+        for (int j = Bits<N>::W - 1; j >= 0; --j) {
+            uint64_t gd = j - q >= 0 ? G.w[j - q] : 0, pd = j - q >= 0 ? P.w[j - q] : 0;
+            if (r) {
+                uint64_t gl = j - q - 1 >= 0 ? G.w[j - q - 1] : 0, pl = j - q - 1 >= 0 ? P.w[j - q - 1] : 0;
+                gd = (gd << r) | (gl >> (64 - r)); pd = (pd << r) | (pl >> (64 - r));
+            }
+            G.w[j] = G.w[j] | (m.w[j] & P.w[j] & gd);
+            P.w[j] = P.w[j] & (~m.w[j] | pd);
+        }
+    }
+}
+
+// Cost of g/p generation + the schedule + sum XORs (structure only: host ints are fine here).
+template <int N, int S>
+inline AdderCost prefixCost(const PrefixSchedule<N, S>& s) {
+    int lo[N], depth[N];
+    for (int i = 0; i < N; ++i) { lo[i] = i; depth[i] = 1; }          // g,p: one gate level
+    int gates = 2 * N;
+    for (int t = 0; t < s.steps; ++t) {
+        int nlo[N], ndepth[N];
+        for (int i = 0; i < N; ++i) { nlo[i] = lo[i]; ndepth[i] = depth[i]; }
+        for (int i = 0; i < N; ++i) {
+            if (!s.cells[t].get(i)) continue;
+            int j = i - s.dist[t];
+            nlo[i] = lo[j];
+            ndepth[i] = (depth[i] > depth[j] ? depth[i] : depth[j]) + 2;
+            gates += (lo[j] == 0) ? 2 : 3;
+        }
+        for (int i = 0; i < N; ++i) { lo[i] = nlo[i]; depth[i] = ndepth[i]; }
+    }
+    gates += N - 1;                                                     // sum XORs (bit 0 has no carry-in)
+    int d = depth[N - 1];                                               // carry out
+    for (int i = 0; i + 1 < N; ++i) if (depth[i] + 1 > d) d = depth[i] + 1;
+    return { gates, d };
+}
+
+template <int N, int S>
+inline void prefixAdd(const PrefixSchedule<N, S>& s, const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) {
+    Bits<N> G, P, p, c;
+    for (int j = 0; j < Bits<N>::W; ++j) { G.w[j] = A.w[j] & B.w[j]; P.w[j] = A.w[j] ^ B.w[j]; }
+    p = P;
+    runPrefix(s, G, P);
+    carryOut = G.get(N - 1);
+    wireShiftUp(G, 1, c);                                               // carry into bit i = G[i-1]
+    for (int j = 0; j < Bits<N>::W; ++j) R.w[j] = p.w[j] ^ c.w[j];
+}
+
+// cell mask helper: positions i in [from, N) with pred(i)
+template <int N, class Pred>
+inline Bits<N> cellMask(int from, Pred pred) {
+    Bits<N> m;
+    for (int i = from; i < N; ++i) if (pred(i)) m.put(i, 1);
+    return m;
+}
+
+// ---------------- The family ----------------
+// Common interface:
+//   template <int N> static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut);
+//   template <int N> static AdderCost cost();
+//   static const char* name();
+
+// Serial fullAdder chain (addBits). Up to 32 bits it runs a byte at a time through the slice
+// tables; wider chains of dependent lookups into the 256 KB table lose to the settle loop.
+struct RippleCarry {
+    static constexpr int kSliceMaxBits = 32;
+    static const char* name() { return "ripple-carry"; }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) {
+        if (N <= kSliceMaxBits) addSlices(A, B, R, carryOut); else addBits(A, B, R, carryOut);
+    }
+    template <int N>
+    static AdderCost cost() {
+        // per fullAdder: 2 XOR + 3 AND + 2 OR; cout = ((a&b)|(a&cin))|(b&cin)
+        int c = 0, d = 0;
+        for (int i = 0; i < N; ++i) {
+            int s = (c > 1 ? c : 1) + 1;
+            if (s > d) d = s;
+            c = (c + 1 > 1 ? c + 1 : 1) + 2;
+        }
+        return { 7 * N, c > d ? c : d };
+    }
+};
+
+// 4-bit lookahead groups; group carries ripple from group to group.
+struct CarryLookahead {
+    static const char* name() { return "carry-lookahead (4-bit groups)"; }
+    // 2 in-group steps, one per group carry above the first group, a short top group, 3 fills
+    template <int N>
+    static constexpr int steps() { return 2 + (N > 7 ? (N - 4) / 4 : 0) + 1 + 3; }
+    template <int N>
+    static const PrefixSchedule<N, steps<N>()>& schedule() {
+        static const PrefixSchedule<N, steps<N>()> s = []{
+            PrefixSchedule<N, steps<N>()> t;
+            // lookahead inside each group: every position gets its in-group (G,P)
+            t.add(1, cellMask<N>(1, [](int i){ return i % 4 >= 1; }));
+            t.add(2, cellMask<N>(2, [](int i){ return i % 4 >= 2; }));
+            // group carries ripple: the top of each group takes the previous group's carry
+            for (int g = 7; g < N; g += 4) t.add(4, cellMask<N>(g, [g](int i){ return i == g; }));
+            int last = N - 1;                                   // short top group
+            if (last % 4 != 3 && last >= 4) t.add(last % 4 + 1, cellMask<N>(last, [last](int i){ return i == last; }));
+            // every other position takes the carry into its group
+            for (int k = 0; k < 3; ++k) t.add(k + 1, cellMask<N>(4, [k](int i){ return i % 4 == k; }));
+            return t;
+        }();
+        return s;
+    }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) { prefixAdd(schedule<N>(), A, B, R, carryOut); }
+    template <int N>
+    static AdderCost cost() { return prefixCost(schedule<N>()); }
+};
+
+// Minimum depth, maximum cells: every position combines at distance 1, 2, 4, ...
+struct KoggeStone {
+    static const char* name() { return "Kogge-Stone"; }
+    template <int N>
+    static constexpr int steps() { return prefixLevels(N); }
+    template <int N>
+    static const PrefixSchedule<N, steps<N>()>& schedule() {
+        static const PrefixSchedule<N, steps<N>()> s = []{
+            PrefixSchedule<N, steps<N>()> t;
+            for (int d = 1; d < N; d += d) t.add(d, cellMask<N>(d, [](int){ return true; }));
+            return t;
+        }();
+        return s;
+    }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) { prefixAdd(schedule<N>(), A, B, R, carryOut); }
+    template <int N>
+    static AdderCost cost() { return prefixCost(schedule<N>()); }
+};
+
+// Minimum cells: up-sweep builds power-of-two groups, down-sweep fills the gaps.
+struct BrentKung {
+    static const char* name() { return "Brent-Kung"; }
+    template <int N>
+    static constexpr int steps() { return 2 * prefixLevels(N); }
+    template <int N>
+    static const PrefixSchedule<N, steps<N>()>& schedule() {
+        static const PrefixSchedule<N, steps<N>()> s = []{
+            PrefixSchedule<N, steps<N>()> t;
+            int top = 1;
+            for (int d = 1; d < N; d += d) {
+                t.add(d, cellMask<N>(d, [d](int i){ return (i + 1) % (d + d) == 0; }));
+                top = d;
+            }
+            for (int d = top / 2; d >= 1; d /= 2)
+                t.add(d, cellMask<N>(d + d, [d](int i){ return (i + 1) % (d + d) == d; }));
+            return t;
+        }();
+        return s;
+    }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) { prefixAdd(schedule<N>(), A, B, R, carryOut); }
+    template <int N>
+    static AdderCost cost() { return prefixCost(schedule<N>()); }
+};
+
+// Kogge-Stone on the odd positions only, then one extra level for the even ones.
+struct HanCarlson {
+    static const char* name() { return "Han-Carlson"; }
+    template <int N>
+    static constexpr int steps() { return prefixLevels(N) + 1; }
+    template <int N>
+    static const PrefixSchedule<N, steps<N>()>& schedule() {
+        static const PrefixSchedule<N, steps<N>()> s = []{
+            PrefixSchedule<N, steps<N>()> t;
+            t.add(1, cellMask<N>(1, [](int i){ return i % 2 == 1; }));
+            for (int d = 2; d < N; d += d) t.add(d, cellMask<N>(d + 1, [](int i){ return i % 2 == 1; }));
+            t.add(1, cellMask<N>(2, [](int i){ return i % 2 == 0; }));
+            return t;
+        }();
+        return s;
+    }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) { prefixAdd(schedule<N>(), A, B, R, carryOut); }
+    template <int N>
+    static AdderCost cost() { return prefixCost(schedule<N>()); }
+};
+
+// 8-bit blocks: every block after the first has two ripple-carry adders (carry-in 0 and 1),
+// and the real block carry picks one sum through a multiplexer.
+struct CarrySelect {
+    static constexpr int kBlock = 8;
+    static const char* name() { return "carry-select (8-bit blocks)"; }
+
+    // A block is exactly one 8-bit slice: its two ripple adders are the table's carry-in 0
+    // and carry-in 1 rows (all looked up independently), then the block carries run the
+    // multiplexer chain.
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) {
+        constexpr int kBlocks = (N + kBlock - 1) / kBlock;
+        SliceAdd s0[kBlocks], s1[kBlocks];
+        for (int b = 0; b < kBlocks; ++b) {
+            int x = busByte(A, b), y = busByte(B, b);
+            s0[b] = kSlice8.add[0][y][x];
+            s1[b] = kSlice8.add[1][y][x];
+        }
+        Bits<N> r;
+        int c = 0;
+        for (int b = 0; b < kBlocks; ++b) {
+            const SliceAdd& e = c ? s1[b] : s0[b];
+            placeByte(r, b, e.sum);
+            c = sliceCarry<N>(e, b);
+        }
+        trimTop(r);
+        carryOut = c;
+        R = r;
+    }
+
+    template <int N>
+    static AdderCost cost() {
+        int blocks = (N + kBlock - 1) / kBlock;
+        int first = N < kBlock ? N : kBlock;
+        int rest = N - first;
+        // ripple adders (7 gates/bit), a sum mux per later bit and a carry mux per later block (3 gates each)
+        int gates = 7 * first + 2 * 7 * rest + 3 * rest + 3 * (blocks - 1);
+        AdderCost rc = RippleCarry::cost<kBlock>();
+        int carryDepth = 3 * first;                     // ripple carry out of the first block
+        int depth = rc.depth;
+        for (int b = 1; b < blocks; ++b) {
+            int blockCarries = 3 * kBlock;              // both adders settle in parallel with the chain
+            int sel = (carryDepth > blockCarries ? carryDepth : blockCarries) + 2;
+            int sumMux = (carryDepth > rc.depth ? carryDepth : rc.depth) + 2;
+            if (sumMux > depth) depth = sumMux;
+            carryDepth = sel;
+        }
+        return { gates, carryDepth > depth ? carryDepth : depth };
+    }
+};
+
+// ---- two's complement negate (invert, then +1 through the chosen adder) ----
+template <class Adder = RippleCarry, int N>
+inline void negateTwos(const Bits<N>& A,Bits<N>& R){
+    Bits<N> inv;
+    for(int j=0;j<Bits<N>::W;++j) inv.w[j] = ~A.w[j];
+    trimTop(inv);
+    Bits<N> one; one.set(N-1,1);
+    int c=0;
+    Adder::add(inv,one,R,c);
+}
@@ -0,0 +1,76 @@
+// adders_bench.cpp - cost model and speed of every adder in adders.h, checked against ripple-carry
+// Build: g++ -O2 -std=c++17 adders_bench.cpp -o adders_bench
+// Usage: adders_bench [additions]
+// The units pick their adder at compile time, e.g. -DMUL_ADDER=KoggeStone -DDIV_ADDER=BrentKung.
+#include "numeric_ops.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+template <int N>
+struct Operands {
+    vector<Bits<N>> a, b;
+    explicit Operands(size_t n) : a(n), b(n) {
+        for(size_t i=0;i<n;++i){
+            for(int j=0;j<Bits<N>::W;++j){
+                a[i].w[j]=rnd64();
+                b[i].w[j]= i%5==0 ? ~a[i].w[j] : rnd64();   // every 5th: carry propagates the full width
+            }
+            trimTop(a[i]); trimTop(b[i]);
+        }
+    }
+};
+
+// the same ripple chain gate by gate (the settle loop), for the slice-table speedup
+struct GateRipple {
+    static const char* name() { return "ripple-carry (fullAdder loop)"; }
+    template <int N>
+    static void add(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& carryOut) { addBits(A, B, R, carryOut); }
+    template <int N>
+    static AdderCost cost() { return RippleCarry::cost<N>(); }
+};
+
+template <class Adder, int N>
+static void row(const Operands<N>& ops, double rippleNs, double* nsOut){
+    size_t n = ops.a.size();
+    vector<Bits<N>> r(n); vector<int> c(n);
+    auto t0 = chrono::steady_clock::now();
+    for(size_t i=0;i<n;++i) Adder::add(ops.a[i], ops.b[i], r[i], c[i]);
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / (double)n;
+    int bad=0;
+    for(size_t i=0;i<n;++i){ Bits<N> ref; int rc=0; addBits(ops.a[i], ops.b[i], ref, rc); if(!sameBits(ref,r[i]) || rc!=c[i]) bad++; }
+    AdderCost cost = Adder::template cost<N>();
+    printf("%-32s %6d %6d %10.1f %8.2fx  %s\n", Adder::name(), cost.gates, cost.depth, ns,
+           rippleNs > 0 ? rippleNs/ns : 1.0, bad ? "MISMATCH" : "ok");
+    if(nsOut) *nsOut = ns;
+}
+
+template <int N>
+static void table(size_t n){
+    Operands<N> ops(n);
+    printf("N = %d\n%-32s %6s %6s %10s %9s  %s\n", N, "adder", "gates", "depth", "ns/add", "vs ripple", "check");
+    double ripple = 0;
+    row<GateRipple,N>(ops, 0, &ripple);
+    row<RippleCarry,N>(ops, ripple, nullptr);
+    row<CarryLookahead,N>(ops, ripple, nullptr);
+    row<CarrySelect,N>(ops, ripple, nullptr);
+    row<BrentKung,N>(ops, ripple, nullptr);
+    row<HanCarlson,N>(ops, ripple, nullptr);
+    row<KoggeStone,N>(ops, ripple, nullptr);
+    printf("\n");
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 200000;
+    printf("gates = 2-input gates, depth = gate levels (see adders.h); %zu additions per row\n\n", n);
+    table<8>(n);
+    table<24>(n);
+    table<32>(n);
+    table<64>(n);
+    return 0;
+}
@@ -0,0 +1,138 @@
+// bits.h - Bits<N> packed bit vectors and the wiring helpers every unit is built from
+#pragma once
+
+#include <cstdint>
+
+// ============================= Types =============================
+// Bits<N>: fixed-width bit vector packed into 64-bit words on the stack.
+// Indexing with [] keeps the old convention: MSB at index 0, LSB at index N-1.
+// Storage: bit at LSB-position p lives in w[p/64], wire (p%64). Bits above N are always 0.
+template <int N>
+struct Bits {
+    static_assert(N > 0, "Bits<N> needs at least one bit");
+    static constexpr int W = (N + 63) / 64;   // storage words
+    uint64_t w[W] = {};                       // w[0] holds the LSB end
+
+    static constexpr int size() { return N; }
+    int operator[](int i) const { return get(N - 1 - i); }
+    void set(int i, int v) { put(N - 1 - i, v); }
+
+    // LSB-position access (position 0 = LSB), used by the wiring helpers below
+    int get(int p) const;
+    void put(int p, int v);
+};
+
+// ============================= Section 0: Storage & Wiring =============================
+// The only host shifts in Sections 0-1 live here, and they never compute a value:
+// they route wire p to wire p+k (or p-k) of the packed storage, the same way a
+// hardware shifter or bus slice is just wiring. All arithmetic goes through gates.
+
+// single-wire select masks, built at compile time
+struct WireMasks {
+    uint64_t m[64];
+    constexpr WireMasks() : m() { for (int k = 0; k < 64; ++k) m[k] = (uint64_t)1 << k; }
+};
+constexpr WireMasks kWire{};
+
+// mask of the storage bits that exist in the top word of Bits<N>
+template <int N>
+constexpr uint64_t topWordMask() { return (N % 64) == 0 ? ~(uint64_t)0 : kWire.m[N % 64] - 1; }
+
+template <int N>
+int Bits<N>::get(int p) const { return (w[p / 64] & kWire.m[p % 64]) ? 1 : 0; }
+
+template <int N>
+void Bits<N>::put(int p, int v) {
+    uint64_t m = kWire.m[p % 64];
+    w[p / 64] = (w[p / 64] & ~m) | (v ? m : 0);
+}
+
+// clear the unused wires above bit N-1
+template <int N>
+inline void trimTop(Bits<N>& x) { x.w[Bits<N>::W - 1] &= topWordMask<N>(); }
+
+// constant buses: every wire tied low / tied high
+template <int N>
+inline Bits<N> zeros() { return Bits<N>{}; }
+template <int N>
+inline Bits<N> ones() { Bits<N> v; for (int j = 0; j < Bits<N>::W; ++j) v.w[j] = ~(uint64_t)0; trimTop(v); return v; }
+
+// y = x routed k wires toward the MSB (wires falling off the top are dropped, 0 enters at the bottom)
+template <int N>
+inline void wireShiftUp(const Bits<N>& x, int k, Bits<N>& y) {
+    const int W = Bits<N>::W, q = k / 64, r = k % 64;
+    Bits<N> t;
+    for (int j = W - 1; j >= 0; --j) {
+        uint64_t hi = (j - q >= 0) ? x.w[j - q] : 0;
+        uint64_t lo = (j - q - 1 >= 0) ? x.w[j - q - 1] : 0;
+        t.w[j] = r ? ((hi << r) | (lo >> (64 - r))) : hi;
+    }
+    trimTop(t);
+    y = t;
+}
+
+// y = x routed k wires toward the LSB (0 enters at the top)
+template <int N>
+inline void wireShiftDown(const Bits<N>& x, int k, Bits<N>& y) {
+    const int W = Bits<N>::W, q = k / 64, r = k % 64;
+    Bits<N> t;
+    for (int j = 0; j < W; ++j) {
+        uint64_t lo = (j + q < W) ? x.w[j + q] : 0;
+        uint64_t hi = (j + q + 1 < W) ? x.w[j + q + 1] : 0;
+        t.w[j] = r ? ((lo >> r) | (hi << (64 - r))) : lo;
+    }
+    y = t;
+}
+
+// y = the low min(N,M) wires of x, zero above (truncate or zero-extend)
+template <int M, int N>
+inline void resizeBits(const Bits<N>& x, Bits<M>& y) {
+    Bits<M> t;
+    for (int j = 0; j < Bits<M>::W && j < Bits<N>::W; ++j) t.w[j] = x.w[j];
+    trimTop(t);
+    y = t;
+}
+
+// y = M wires of x starting at LSB-position p (a bus slice)
+template <int M, int N>
+inline void takeBits(const Bits<N>& x, int p, Bits<M>& y) {
+    Bits<N> t; wireShiftDown(x, p, t); resizeBits(t, y);
+}
+
+// copy all M wires of x into y starting at LSB-position p (other wires of y untouched)
+template <int M, int N>
+inline void placeBits(const Bits<M>& x, int p, Bits<N>& y) {
+    Bits<M> all; for (int j = 0; j < Bits<M>::W; ++j) all.w[j] = ~(uint64_t)0; trimTop(all);
+    Bits<N> v, field;
+    resizeBits(x, v);   wireShiftUp(v, p, v);
+    resizeBits(all, field); wireShiftUp(field, p, field);
+    for (int j = 0; j < Bits<N>::W; ++j) y.w[j] = (y.w[j] & ~field.w[j]) | v.w[j];
+}
+
+// one control wire driving a whole 64-wire word (all ones or all zeros)
+inline uint64_t fanOut(int v) { return v ? ~(uint64_t)0 : 0; }
+
+// a small non-negative bus value read as a host index: a shifter select or table row (control only)
+template <int N>
+inline int busIndex(const Bits<N>& x) { return (int)x.w[0]; }
+
+// wires 8k..8k+7 as a slice-table row, and a slice's 8 output wires placed there (wiring only)
+template <int N>
+inline int busByte(const Bits<N>& x, int k) { return (int)(uint8_t)(x.w[k / 8] >> (k % 8 * 8)); }
+template <int N>
+inline void placeByte(Bits<N>& x, int k, int v) { x.w[k / 8] |= (uint64_t)(uint8_t)v << (k % 8 * 8); }
+
+// wires 32i..32i+31 as a 32-wire bus, and a 64-wire product ORed onto (zero) wires 32i..32i+63
+template <int N>
+inline Bits<32> busLimb(const Bits<N>& x, int i) { Bits<32> y; y.w[0] = (uint32_t)(x.w[i / 2] >> (i % 2 * 32)); return y; }
+template <int N>
+inline void placeLimbs(Bits<N>& x, int i, const Bits<64>& v) {
+    x.w[i / 2] |= v.w[0] << (i % 2 * 32);
+    if (i % 2 && i / 2 + 1 < Bits<N>::W) x.w[i / 2 + 1] |= v.w[0] >> 32;
+}
+
+template <int N>
+inline bool sameBits(const Bits<N>& a, const Bits<N>& b) {
+    for (int j = 0; j < Bits<N>::W; ++j) if (a.w[j] != b.w[j]) return false;
+    return true;
+}
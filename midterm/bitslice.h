@@ -0,0 +1,376 @@
+// bitslice.h - bit-sliced batch engine: 256 independent operations per pass
+// A SlicedBits<N> holds N bit-planes; plane p holds bit p (LSB-position) of 256
+// operands, one per lane. Every unit below is the same gate-level circuit as in
+// numeric_ops.h, evaluated with one XOR/AND/OR per gate for all 256 lanes at once.
+// Build with -mavx2 to put a plane in one AVX2 register; without it a plane is
+// four 64-bit words and the same code runs portably.
+#pragma once
+
+#include "numeric_ops.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ============================= Lane256: one bit-plane =============================
+#if defined(__AVX2__)
+struct Lane256 {
+    __m256i v;
+    static Lane256 zero() { return { _mm256_setzero_si256() }; }
+    static Lane256 ones() { return { _mm256_set1_epi64x(-1) }; }
+    static Lane256 fromWords(const uint64_t q[4]) { return { _mm256_loadu_si256((const __m256i*)q) }; }
+    void toWords(uint64_t q[4]) const { _mm256_storeu_si256((__m256i*)q, v); }
+    bool any() const { return !_mm256_testz_si256(v, v); }
+};
+inline Lane256 operator&(Lane256 a, Lane256 b) { return { _mm256_and_si256(a.v, b.v) }; }
+inline Lane256 operator|(Lane256 a, Lane256 b) { return { _mm256_or_si256(a.v, b.v) }; }
+inline Lane256 operator^(Lane256 a, Lane256 b) { return { _mm256_xor_si256(a.v, b.v) }; }
+inline Lane256 operator~(Lane256 a) { return { _mm256_xor_si256(a.v, _mm256_set1_epi64x(-1)) }; }
+inline Lane256 andNot(Lane256 a, Lane256 b) { return { _mm256_andnot_si256(a.v, b.v) }; } // ~a & b
+#else
+struct Lane256 {
+    uint64_t q[4];
+    static Lane256 zero() { return { { 0, 0, 0, 0 } }; }
+    static Lane256 ones() { return { { ~(uint64_t)0, ~(uint64_t)0, ~(uint64_t)0, ~(uint64_t)0 } }; }
+    static Lane256 fromWords(const uint64_t w[4]) { return { { w[0], w[1], w[2], w[3] } }; }
+    void toWords(uint64_t w[4]) const { for (int i = 0; i < 4; ++i) w[i] = q[i]; }
+    bool any() const { return (q[0] | q[1] | q[2] | q[3]) != 0; }
+};
+inline Lane256 operator&(Lane256 a, Lane256 b) { for (int i = 0; i < 4; ++i) a.q[i] &= b.q[i]; return a; }
+inline Lane256 operator|(Lane256 a, Lane256 b) { for (int i = 0; i < 4; ++i) a.q[i] |= b.q[i]; return a; }
+inline Lane256 operator^(Lane256 a, Lane256 b) { for (int i = 0; i < 4; ++i) a.q[i] ^= b.q[i]; return a; }
+inline Lane256 operator~(Lane256 a) { for (int i = 0; i < 4; ++i) a.q[i] = ~a.q[i]; return a; }
+inline Lane256 andNot(Lane256 a, Lane256 b) { for (int i = 0; i < 4; ++i) a.q[i] = ~a.q[i] & b.q[i]; return a; }
+#endif
+
+// 2:1 multiplexer per lane: m ? a : b
+inline Lane256 select(Lane256 m, Lane256 a, Lane256 b) { return (m & a) | andNot(m, b); }
+
+constexpr int kSliceLanes = 256;
+
+template <int N>
+struct SlicedBits {
+    Lane256 b[N];   // b[p] = bit p (LSB-position) of every lane
+};
+
+// ============================= Transpose (TEST/IO side: host shifts allowed) =============================
+// Four independent in-place 64x64 bit-matrix transposes, one per 64-lane block:
+// afterwards bit c of a[r][blk] is the old bit r of a[c][blk]. Swaps ever smaller
+// off-diagonal blocks (32, 16, ..., 1); with AVX2 all four blocks move together.
+inline void transpose64x4(uint64_t a[64][4]) {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+#if defined(__AVX2__)
+    __m256i r[64];
+    for (int i = 0; i < 64; ++i) r[i] = _mm256_loadu_si256((const __m256i*)a[i]);
+    for (int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+        const __m256i mv = _mm256_set1_epi64x((long long)m);
+        const __m128i cnt = _mm_cvtsi32_si128(j);
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            __m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srl_epi64(r[k], cnt), r[k | j]), mv);
+            r[k] = _mm256_xor_si256(r[k], _mm256_sll_epi64(t, cnt));
+            r[k | j] = _mm256_xor_si256(r[k | j], t);
+        }
+    }
+    for (int i = 0; i < 64; ++i) _mm256_storeu_si256((__m256i*)a[i], r[i]);
+#else
+    for (int j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            for (int blk = 0; blk < 4; ++blk) {
+                uint64_t t = ((a[k][blk] >> j) ^ a[k | j][blk]) & m;
+                a[k][blk] ^= t << j;
+                a[k | j][blk] ^= t;
+            }
+        }
+    }
+#endif
+}
+
+// Lanes >= count are filled with zero operands.
+template <int N>
+inline void sliceIn(const Bits<N>* ops, size_t count, SlicedBits<N>& s) {
+    for (int wi = 0; wi < Bits<N>::W; ++wi) {
+        uint64_t rows[64][4];
+        for (int blk = 0; blk < 4; ++blk)
+            for (int i = 0; i < 64; ++i) {
+                size_t l = (size_t)blk * 64 + i;
+                rows[i][blk] = l < count ? ops[l].w[wi] : 0;
+            }
+        transpose64x4(rows);
+        for (int p = 0; p < 64 && wi * 64 + p < N; ++p) s.b[wi * 64 + p] = Lane256::fromWords(rows[p]);
+    }
+}
+
+template <int N>
+inline void sliceOut(const SlicedBits<N>& s, Bits<N>* ops, size_t count) {
+    for (int wi = 0; wi < Bits<N>::W; ++wi) {
+        uint64_t rows[64][4];
+        for (int p = 0; p < 64; ++p) {
+            if (wi * 64 + p < N) s.b[wi * 64 + p].toWords(rows[p]);
+            else for (int blk = 0; blk < 4; ++blk) rows[p][blk] = 0;
+        }
+        transpose64x4(rows);
+        for (int blk = 0; blk < 4; ++blk)
+            for (int i = 0; i < 64; ++i) {
+                size_t l = (size_t)blk * 64 + i;
+                if (l < count) ops[l].w[wi] = rows[i][blk];
+            }
+    }
+}
+
+// one flag per lane <-> int
+inline void laneFlagsOut(Lane256 f, int* out, size_t count) {
+    uint64_t q[4]; f.toWords(q);
+    for (size_t l = 0; l < count && l < (size_t)kSliceLanes; ++l) out[l] = (int)((q[l / 64] >> (l % 64)) & 1ULL);
+}
+
+// ============================= Sliced gate-level units (XOR/AND/OR only) =============================
+
+// ---- ripple-carry add over positions [from, N): positions below 'from' pass A through ----
+// Used by the multiplier, whose addend is zero below the current step.
+template <int N>
+inline void sliceAddFrom(const SlicedBits<N>& A, const SlicedBits<N>& B, int from, Lane256 cin,
+                         SlicedBits<N>& R, Lane256& carryOut) {
+    Lane256 c = cin;
+    for (int p = 0; p < from; ++p) R.b[p] = A.b[p];
+    for (int p = from; p < N; ++p) {
+        Lane256 s, k;
+        fullAdder(A.b[p], B.b[p], c, s, k);
+        R.b[p] = s; c = k;
+    }
+    carryOut = c;
+}
+
+template <int N>
+inline void sliceAdd(const SlicedBits<N>& A, const SlicedBits<N>& B, SlicedBits<N>& R, Lane256& carryOut) {
+    sliceAddFrom(A, B, 0, Lane256::zero(), R, carryOut);
+}
+
+// ---- two's complement negate: ~A + 1 (half-adder chain) ----
+template <int N>
+inline void sliceNegate(const SlicedBits<N>& A, SlicedBits<N>& R) {
+    Lane256 c = Lane256::ones();
+    for (int p = 0; p < N; ++p) {
+        Lane256 inv = ~A.b[p];
+        R.b[p] = inv ^ c;
+        c = inv & c;
+    }
+}
+
+// per-lane R = m ? A : B
+template <int N>
+inline void sliceSelect(Lane256 m, const SlicedBits<N>& A, const SlicedBits<N>& B, SlicedBits<N>& R) {
+    for (int p = 0; p < N; ++p) R.b[p] = select(m, A.b[p], B.b[p]);
+}
+
+template <int N>
+inline Lane256 sliceIsZero(const SlicedBits<N>& A) {
+    Lane256 any = Lane256::zero();
+    for (int p = 0; p < N; ++p) any = any | A.b[p];
+    return ~any;
+}
+
+template <int N>
+inline Lane256 sliceEquals(const SlicedBits<N>& A, const SlicedBits<N>& B) {
+    Lane256 diff = Lane256::zero();
+    for (int p = 0; p < N; ++p) diff = diff | (A.b[p] ^ B.b[p]);
+    return ~diff;
+}
+
+// |x| per lane (two's complement), like absSigned
+template <int N>
+inline void sliceAbs(const SlicedBits<N>& x, SlicedBits<N>& y) {
+    SlicedBits<N> n; sliceNegate(x, n);
+    sliceSelect(x.b[N - 1], n, x, y);
+}
+
+// ---------------- ALU (ADD/SUB) with flags ----------------
+// 'subtract' is per lane, so ADD and SUB may be mixed in one pass.
+struct SlicedALUResult { SlicedBits<32> result; Lane256 N, Z, C, V; };
+
+inline void sliceALU(const SlicedBits<32>& a, const SlicedBits<32>& b, Lane256 subtract, SlicedALUResult& out) {
+    SlicedBits<32> negB, opB;
+    sliceNegate(b, negB);
+    sliceSelect(subtract, negB, b, opB);
+    sliceAdd(a, opB, out.result, out.C);
+    Lane256 sa = a.b[31], sb = b.b[31], sr = out.result.b[31];
+    Lane256 signsDiffer = sa ^ sb, resFlipped = sr ^ sa;
+    out.N = sr;
+    out.Z = sliceIsZero(out.result);
+    out.V = select(subtract, signsDiffer & resFlipped, andNot(signsDiffer, resFlipped));
+}
+
+// ---------------- MUL family (shift-add) ----------------
+// Shifting the multiplicand is just wiring: at step s, addend bit p is multiplicand bit p-s.
+// Below position s the addend is zero (nothing changes); above s+31 only the carry ripples on.
+inline void sliceMulUnsigned32x32(const SlicedBits<32>& ua, const SlicedBits<32>& ub, SlicedBits<64>& acc) {
+    for (int p = 0; p < 64; ++p) acc.b[p] = Lane256::zero();
+    for (int step = 0; step < 32; ++step) {
+        Lane256 lsb = ub.b[step];
+        if (!lsb.any()) continue;                       // no lane adds this step
+        Lane256 c = Lane256::zero();
+        for (int p = step; p < step + 32; ++p) {
+            Lane256 s, k;
+            fullAdder(acc.b[p], ua.b[p - step] & lsb, c, s, k);
+            acc.b[p] = s; c = k;
+        }
+        for (int p = step + 32; p < 64; ++p) {          // half adders: addend bit is 0
+            Lane256 s = acc.b[p] ^ c;
+            c = acc.b[p] & c;
+            acc.b[p] = s;
+        }                                               // carry beyond 64 ignored
+    }
+}
+
+// product fits in signed 32 bits <=> bits 63..32 all equal bit 31
+inline Lane256 sliceMulOverflowFlag(const SlicedBits<64>& prod) {
+    Lane256 diff = Lane256::zero();
+    for (int p = 32; p < 64; ++p) diff = diff | (prod.b[p] ^ prod.b[31]);
+    return diff;
+}
+
+struct SlicedMulOut { SlicedBits<32> low32, high32; Lane256 overflow; };
+
+inline void sliceSplitHiLo(const SlicedBits<64>& prod, SlicedMulOut& out) {
+    for (int p = 0; p < 32; ++p) { out.low32.b[p] = prod.b[p]; out.high32.b[p] = prod.b[32 + p]; }
+}
+
+inline void sliceMul_ss(const SlicedBits<32>& a, const SlicedBits<32>& b, SlicedMulOut& out) {
+    SlicedBits<32> aa, bb; sliceAbs(a, aa); sliceAbs(b, bb);
+    Lane256 neg = a.b[31] ^ b.b[31];
+    SlicedBits<64> prod, nprod;
+    sliceMulUnsigned32x32(aa, bb, prod);
+    sliceNegate(prod, nprod);                            // -0 == 0, so no zero check is needed
+    sliceSelect(neg, nprod, prod, prod);
+    sliceSplitHiLo(prod, out);
+    out.overflow = sliceMulOverflowFlag(prod);
+}
+
+inline void sliceMul_uu(const SlicedBits<32>& a, const SlicedBits<32>& b, SlicedMulOut& out) {
+    SlicedBits<64> prod;
+    sliceMulUnsigned32x32(a, b, prod);
+    sliceSplitHiLo(prod, out);
+    out.overflow = Lane256::zero();
+}
+
+inline void sliceMul_su(const SlicedBits<32>& a, const SlicedBits<32>& b, SlicedMulOut& out) {
+    SlicedBits<32> aa; sliceAbs(a, aa);
+    SlicedBits<64> prod, nprod;
+    sliceMulUnsigned32x32(aa, b, prod);
+    sliceNegate(prod, nprod);
+    sliceSelect(a.b[31], nprod, prod, prod);
+    sliceSplitHiLo(prod, out);
+    out.overflow = Lane256::zero();
+}
+
+// ---------------- DIV/REM family (restoring division) ----------------
+struct SlicedDivOut { SlicedBits<32> q, r; Lane256 overflow; };
+
+inline void sliceDivu_restoring(const SlicedBits<32>& dividend, const SlicedBits<32>& divisor, SlicedDivOut& out) {
+    SlicedBits<32> R, Q, negD, RminusD;
+    for (int p = 0; p < 32; ++p) { R.b[p] = Lane256::zero(); Q.b[p] = Lane256::zero(); }
+    sliceNegate(divisor, negD);
+    for (int i = 0; i < 32; ++i) {
+        // shift-in next dividend bit (MSB-first): wiring moves every plane up one position
+        for (int p = 31; p > 0; --p) R.b[p] = R.b[p - 1];
+        R.b[0] = dividend.b[31 - i];
+        Lane256 noBorrow;
+        sliceAdd(R, negD, RminusD, noBorrow);            // R - divisor
+        sliceSelect(noBorrow, RminusD, R, R);            // keep or restore
+        for (int p = 31; p > 0; --p) Q.b[p] = Q.b[p - 1];
+        Q.b[0] = noBorrow;
+    }
+    // divide by zero: q = 0xFFFFFFFF, r = dividend
+    Lane256 dz = sliceIsZero(divisor);
+    for (int p = 0; p < 32; ++p) {
+        out.q.b[p] = Q.b[p] | dz;
+        out.r.b[p] = select(dz, dividend.b[p], R.b[p]);
+    }
+    out.overflow = Lane256::zero();
+}
+
+inline void sliceDiv_signed(const SlicedBits<32>& A, const SlicedBits<32>& B, SlicedDivOut& out) {
+    Lane256 sA = A.b[31], sB = B.b[31];
+    SlicedBits<32> ua, ub;
+    sliceAbs(A, ua); sliceAbs(B, ub);
+    SlicedDivOut d;
+    sliceDivu_restoring(ua, ub, d);
+    SlicedBits<32> nq, nr;
+    sliceNegate(d.q, nq); sliceNegate(d.r, nr);
+    sliceSelect(sA ^ sB, nq, d.q, out.q);               // quotient truncates toward zero
+    sliceSelect(sA, nr, d.r, out.r);                    // remainder sign follows dividend
+
+    // INT_MIN / -1: q = INT_MIN, r = 0, overflow
+    Lane256 aIsIntMin = A.b[31], bIsNeg1 = Lane256::ones();
+    for (int p = 0; p < 31; ++p) aIsIntMin = andNot(A.b[p], aIsIntMin);
+    for (int p = 0; p < 32; ++p) bIsNeg1 = bIsNeg1 & B.b[p];
+    Lane256 ovf = aIsIntMin & bIsNeg1;
+    // divide by zero: q = -1, r = A
+    Lane256 dz = sliceIsZero(B);
+    for (int p = 0; p < 32; ++p) {
+        Lane256 qIntMin = (p == 31) ? Lane256::ones() : Lane256::zero();
+        out.q.b[p] = select(dz, Lane256::ones(), select(ovf, qIntMin, out.q.b[p]));
+        out.r.b[p] = select(dz, A.b[p], andNot(ovf, out.r.b[p]));
+    }
+    out.overflow = andNot(dz, ovf);
+}
+
+// ============================= Batch API over plain Bits<32> arrays =============================
+// Each call processes 'count' independent operations, 256 per pass, and writes
+// the same results the scalar units in numeric_ops.h would.
+
+inline void ALU_batch(const Bits<32>* a, const Bits<32>* b, const int* subtract, ALUResult* out, size_t count) {
+    for (size_t base = 0; base < count; base += kSliceLanes) {
+        size_t n = count - base < (size_t)kSliceLanes ? count - base : (size_t)kSliceLanes;
+        SlicedBits<32> A, B;
+        sliceIn(a + base, n, A); sliceIn(b + base, n, B);
+        uint64_t q[4] = { 0, 0, 0, 0 };
+        for (size_t l = 0; l < n; ++l) if (subtract[base + l]) q[l / 64] |= 1ULL << (l % 64);
+        SlicedALUResult r;
+        sliceALU(A, B, Lane256::fromWords(q), r);
+        Bits<32> res[kSliceLanes];
+        int fN[kSliceLanes], fZ[kSliceLanes], fC[kSliceLanes], fV[kSliceLanes];
+        sliceOut(r.result, res, n);
+        laneFlagsOut(r.N, fN, n); laneFlagsOut(r.Z, fZ, n); laneFlagsOut(r.C, fC, n); laneFlagsOut(r.V, fV, n);
+        for (size_t l = 0; l < n; ++l) out[base + l] = ALUResult{ res[l], ALUFlags{ fN[l], fZ[l], fC[l], fV[l] } };
+    }
+}
+
+template <class Kernel>
+inline void mulBatch(const Bits<32>* a, const Bits<32>* b, MulOut* out, size_t count, Kernel k) {
+    for (size_t base = 0; base < count; base += kSliceLanes) {
+        size_t n = count - base < (size_t)kSliceLanes ? count - base : (size_t)kSliceLanes;
+        SlicedBits<32> A, B;
+        sliceIn(a + base, n, A); sliceIn(b + base, n, B);
+        SlicedMulOut r;
+        k(A, B, r);
+        Bits<32> lo[kSliceLanes], hi[kSliceLanes];
+        int of[kSliceLanes];
+        sliceOut(r.low32, lo, n); sliceOut(r.high32, hi, n); laneFlagsOut(r.overflow, of, n);
+        for (size_t l = 0; l < n; ++l) out[base + l] = MulOut{ lo[l], hi[l], of[l] };
+    }
+}
+
+inline void mul_ss_batch(const Bits<32>* a, const Bits<32>* b, MulOut* out, size_t count) { mulBatch(a, b, out, count, sliceMul_ss); }
+inline void mul_su_batch(const Bits<32>* a, const Bits<32>* b, MulOut* out, size_t count) { mulBatch(a, b, out, count, sliceMul_su); }
+inline void mul_uu_batch(const Bits<32>* a, const Bits<32>* b, MulOut* out, size_t count) { mulBatch(a, b, out, count, sliceMul_uu); }
+
+template <class Out, class Kernel>
+inline void divBatch(const Bits<32>* a, const Bits<32>* b, Out* out, size_t count, Kernel k) {
+    for (size_t base = 0; base < count; base += kSliceLanes) {
+        size_t n = count - base < (size_t)kSliceLanes ? count - base : (size_t)kSliceLanes;
+        SlicedBits<32> A, B;
+        sliceIn(a + base, n, A); sliceIn(b + base, n, B);
+        SlicedDivOut r;
+        k(A, B, r);
+        Bits<32> q[kSliceLanes], rem[kSliceLanes];
+        int of[kSliceLanes];
+        sliceOut(r.q, q, n); sliceOut(r.r, rem, n); laneFlagsOut(r.overflow, of, n);
+        for (size_t l = 0; l < n; ++l) out[base + l] = Out{ q[l], rem[l], of[l] };
+    }
+}
+
+inline void divu_restoring_batch(const Bits<32>* a, const Bits<32>* b, DivOut* out, size_t count) { divBatch(a, b, out, count, sliceDivu_restoring); }
+inline void div_signed_batch(const Bits<32>* a, const Bits<32>* b, DivPair* out, size_t count) { divBatch(a, b, out, count, sliceDiv_signed); }
@@ -0,0 +1,80 @@
+// bitslice_bench.cpp - cross-check the 256-lane bit-sliced units against the scalar ones and time both
+// Build: g++ -O2 -mavx2 -std=c++17 bitslice_bench.cpp -o bitslice_bench
+// Usage: bitslice_bench [operations]
+#include "bitslice.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static unsigned rngState = 2463534242u;
+static int rnd(){ rngState^=rngState<<13; rngState^=rngState>>17; rngState^=rngState<<5; return (int)rngState; }
+
+template <class F>
+static double nsPerOp(size_t count, F f){
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / (double)count;
+}
+
+static bool sameALU(const ALUResult& x, const ALUResult& y){
+    return sameBits(x.result,y.result) && x.flags.N==y.flags.N && x.flags.Z==y.flags.Z && x.flags.C==y.flags.C && x.flags.V==y.flags.V;
+}
+static bool sameMul(const MulOut& x, const MulOut& y){ return sameBits(x.low32,y.low32) && sameBits(x.high32,y.high32) && x.overflow==y.overflow; }
+template <class D> static bool sameDiv(const D& x, const D& y){ return sameBits(x.q,y.q) && sameBits(x.r,y.r) && x.overflow==y.overflow; }
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    vector<Bits<32>> a(n), b(n);
+    vector<int> sub(n);
+    for(size_t i=0;i<n;++i){
+        int x=rnd(), y=rnd();
+        if(i%7==0) y&=0xFF;                          // small divisors
+        if(i%11==0) y=0;                             // divide by zero
+        if(i%13==0){ x=(int)0x80000000; y=-1; }      // INT_MIN / -1
+        a[i]=intToBits(x); b[i]=intToBits(y); sub[i]=(int)(i&1);
+    }
+#if defined(__AVX2__)
+    printf("bit-sliced engine: AVX2, %d lanes per pass, %zu operations\n\n", kSliceLanes, n);
+#else
+    printf("bit-sliced engine: portable 4x64-bit planes, %d lanes per pass, %zu operations\n\n", kSliceLanes, n);
+#endif
+    printf("%-16s %12s %12s %9s  %s\n", "unit", "scalar ns/op", "sliced ns/op", "speedup", "check");
+    int failures = 0;
+
+    auto report = [&](const char* name, double s, double v, size_t bad){
+        printf("%-16s %12.1f %12.2f %8.1fx  %s\n", name, s, v, s/v, bad ? "MISMATCH" : "ok");
+        if(bad){ failures++; }
+    };
+
+    {   vector<ALUResult> ref(n), got(n);
+        double s = nsPerOp(n,[&]{ for(size_t i=0;i<n;++i) ALU(a[i],b[i],sub[i]!=0,ref[i]); });
+        double v = nsPerOp(n,[&]{ ALU_batch(a.data(),b.data(),sub.data(),got.data(),n); });
+        size_t bad=0; for(size_t i=0;i<n;++i) bad += !sameALU(ref[i],got[i]);
+        report("ALU add/sub", s, v, bad); }
+
+    struct MulUnit { const char* name; void (*scalar)(const Bits<32>&,const Bits<32>&,MulOut&,bool); void (*batch)(const Bits<32>*,const Bits<32>*,MulOut*,size_t); };
+    const MulUnit muls[] = { {"mul_ss",mul_ss,mul_ss_batch}, {"mul_su",mul_su,mul_su_batch}, {"mul_uu",mul_uu,mul_uu_batch} };
+    for(const MulUnit& u : muls){
+        vector<MulOut> ref(n), got(n);
+        double s = nsPerOp(n,[&]{ for(size_t i=0;i<n;++i) u.scalar(a[i],b[i],ref[i],false); });
+        double v = nsPerOp(n,[&]{ u.batch(a.data(),b.data(),got.data(),n); });
+        size_t bad=0; for(size_t i=0;i<n;++i) bad += !sameMul(ref[i],got[i]);
+        report(u.name, s, v, bad);
+    }
+
+    {   vector<DivOut> ref(n), got(n);
+        double s = nsPerOp(n,[&]{ for(size_t i=0;i<n;++i) divu_restoring(a[i],b[i],ref[i],false); });
+        double v = nsPerOp(n,[&]{ divu_restoring_batch(a.data(),b.data(),got.data(),n); });
+        size_t bad=0; for(size_t i=0;i<n;++i) bad += !sameDiv(ref[i],got[i]);
+        report("divu_restoring", s, v, bad); }
+
+    {   vector<DivPair> ref(n), got(n);
+        double s = nsPerOp(n,[&]{ for(size_t i=0;i<n;++i) div_signed(a[i],b[i],ref[i],false); });
+        double v = nsPerOp(n,[&]{ div_signed_batch(a.data(),b.data(),got.data(),n); });
+        size_t bad=0; for(size_t i=0;i<n;++i) bad += !sameDiv(ref[i],got[i]);
+        report("div_signed", s, v, bad); }
+
+    return failures ? 1 : 0;
+}
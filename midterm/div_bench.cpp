@@ -0,0 +1,76 @@
+// div_bench.cpp - step count and speed of every DIV engine, checked against host division
+// Build: g++ -O2 -std=c++17 div_bench.cpp -o div_bench
+// Usage: div_bench [operations]
+#include "numeric_ops.h"
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static unsigned rngState = 2463534242u;
+static unsigned rnd(){ rngState^=rngState<<13; rngState^=rngState>>17; rngState^=rngState<<5; return rngState; }
+
+struct Case { Bits<32> a, b; unsigned ua, ub; int sa, sb; };
+
+// host reference with the RISC-V edge cases (Section 2 style: host ints are fine outside the units)
+static void expectU(const Case& c, unsigned& q, unsigned& r){
+    if(!c.ub){ q=0xFFFFFFFFu; r=c.ua; return; }
+    q=c.ua/c.ub; r=c.ua%c.ub;
+}
+static void expectS(const Case& c, int& q, int& r){
+    if(!c.sb){ q=-1; r=c.sa; return; }
+    if(c.sa==INT_MIN && c.sb==-1){ q=INT_MIN; r=0; return; }
+    q=c.sa/c.sb; r=c.sa%c.sb;
+}
+
+template <class Engine>
+static void row(const vector<Case>& cases){
+    size_t n = cases.size();
+    vector<DivOut> u(n); vector<DivPair> s(n);
+    long steps = 0, divides = 0;
+    for(size_t i=0;i<n;++i) if(cases[i].ub){ Bits<32> q, r; steps += Engine::divide(cases[i].a, cases[i].b, q, r, false); divides++; }
+
+    auto t0 = chrono::steady_clock::now();
+    for(size_t i=0;i<n;++i) divuWith<Engine>(cases[i].a, cases[i].b, u[i], false);
+    auto t1 = chrono::steady_clock::now();
+    for(size_t i=0;i<n;++i) divSignedWith<Engine>(cases[i].a, cases[i].b, s[i], false);
+    auto t2 = chrono::steady_clock::now();
+    double nsU = chrono::duration<double, nano>(t1 - t0).count() / (double)n;
+    double nsS = chrono::duration<double, nano>(t2 - t1).count() / (double)n;
+
+    int bad = 0;
+    for(size_t i=0;i<n;++i){
+        unsigned q, r; expectU(cases[i], q, r);
+        if((unsigned)bitsToInt(u[i].q)!=q || (unsigned)bitsToInt(u[i].r)!=r) bad++;
+        int sq, sr; expectS(cases[i], sq, sr);
+        if(bitsToInt(s[i].q)!=sq || bitsToInt(s[i].r)!=sr) bad++;
+    }
+    printf("%-16s %10.2f %12.1f %12.1f %9.2f  %s\n", Engine::name(), (double)steps/(double)divides, nsU, nsS,
+           2000.0/(nsU+nsS), bad ? "MISMATCH" : "ok");
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    vector<Case> cases(n);
+    for(size_t i=0;i<n;++i){
+        unsigned x=rnd(), y=rnd();
+        switch(i%8){
+            case 1: y >>= rnd()%32; break;                 // divisors of every size
+            case 2: x >>= rnd()%32; break;                 // small dividends: few quotient bits
+            case 3: y &= 0xFF; break;
+            case 4: y = 0; break;                          // divide by zero
+            case 5: x = 0x80000000u; y = 0xFFFFFFFFu; break; // INT_MIN / -1
+            case 6: y = 1; break;                          // full-width quotient
+        }
+        cases[i].a=intToBits((int)x); cases[i].b=intToBits((int)y);
+        cases[i].ua=x; cases[i].ub=y; cases[i].sa=(int)x; cases[i].sb=(int)y;
+    }
+    printf("%zu operations; steps = iterations per unsigned divide (nonzero divisors)\n\n", n);
+    printf("%-16s %10s %12s %12s %9s  %s\n", "engine", "avg steps", "divu ns/op", "div ns/op", "Mop/s", "check");
+    row<RestoringDiv>(cases);
+    row<NonRestoringDivider>(cases);
+    row<Srt4Divider>(cases);
+    return 0;
+}
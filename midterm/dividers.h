@@ -0,0 +1,180 @@
+// dividers.h - non-restoring and SRT radix-4 divider engines with early termination
+// Both compute an unsigned 32/32 quotient and remainder for a nonzero divisor and return
+// the number of iteration steps they ran. Quotient bits that must be zero (from the
+// operands' leading zeros) are skipped. Divide-by-zero and the signed wrappers stay in
+// numeric_ops.h, which also holds the restoring engine and the DIV_ENGINE selection.
+#pragma once
+
+#include "adders.h"
+#include "trace.h"
+
+#include <cstdint>
+
+// ============================= Section 1c: Dividers (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---------------- Early termination ----------------
+// Leading-zero count: a priority encoder feeding the step counter (control path, host ints).
+template <int N>
+inline int leadingZeros(const Bits<N>& x) {
+    const int W = Bits<N>::W, pad = 64 * W - N;
+    for (int j = W - 1; j >= 0; --j)
+        if (x.w[j]) return __builtin_clzll(x.w[j]) + 64 * (W - 1 - j) - pad;
+    return N;
+}
+
+// n / d < 2^k with k = lz(d) - lz(n) + 1, so only the low k quotient bits can be 1 (k = 0: n < d).
+inline int quotientBits(const Bits<32>& n, const Bits<32>& d) {
+    int k = leadingZeros(d) - leadingZeros(n) + 1;
+    return k > 0 ? k : 0;
+}
+
+// ---------------- Non-restoring (radix 2) ----------------
+// The remainder may go negative; instead of restoring, the next step adds the divisor back.
+// One carry-propagate add per quotient bit, one correction add at the end.
+template <class Adder>
+struct NonRestoringDiv {
+    static const char* name() { return "non-restoring"; }
+
+    template <bool Trace>
+    static void steps(const Bits<32>& n, const Bits<32>& d, int k, Bits<32>& q, Bits<32>& r, TraceRing* ring) {
+        Bits<34> D, negD, R, R2;                       // |2R + bit| < 2d needs 34 signed bits
+        resizeBits(d, D);
+        negateTwos<Adder>(D, negD);
+        takeBits(n, k, R);                             // the dividend prefix with no quotient bits: R < d
+        if constexpr (Trace) ring->begin(T_DIV_NONRESTORING, traceWord(n), traceWord(d));
+        int neg = 0, c = 0;
+        for (int i = k - 1; i >= 0; --i) {
+            wireShiftUp(R, 1, R2); R2.put(0, n.get(i));
+            Adder::add(R2, neg ? D : negD, R, c);      // R >= 0: subtract d, R < 0: add d
+            neg = R.get(33);
+            wireShiftUp(q, 1, q); q.put(0, !neg);
+            if constexpr (Trace) ring->step(k - 1 - i, traceWord(R), 0, (uint32_t)traceWord(q), !neg);
+        }
+        if (neg) Adder::add(R, D, R, c);
+        resizeBits(R, r);
+    }
+
+    static int divide(const Bits<32>& n, const Bits<32>& d, Bits<32>& q, Bits<32>& r, bool trace) {
+        int k = quotientBits(n, d);
+        q = Bits<32>{};
+        if (!k) { r = n; return 0; }
+        if (TraceRing* ring = traceTarget(trace)) steps<true>(n, d, k, q, r, ring);
+        else steps<false>(n, d, k, q, r, nullptr);
+        return k;
+    }
+};
+
+// ---------------- SRT radix 4 ----------------
+// Digits q in {-2..2} (redundancy rho = 2/3) retire two quotient bits per step.
+// The divisor is normalized to [1/2,1) and the partial remainder w is kept in carry-save
+// form (sum row + carry row), so a step is one row of 3:2 counters: w' = 4w - q*d.
+// q comes from a table indexed by 3 divisor bits below the leading 1 and an 8-bit
+// estimate of 4w (top bits of both rows through a short adder, 4 fraction bits).
+// The quotient is assembled on the fly from Q and QM = Q - 1 without any carry.
+struct Srt4Table {
+    int8_t digit[8][256];   // [divisor bits][estimate as unsigned byte]
+    int ok = 1;             // selection intervals overlap enough for every divisor range
+
+    // Selection constants in units of 1/16 for d in [(8+i)/16, (9+i)/16): choose q >= k
+    // iff estimate >= m_k. Needs m_k >= max (k - 2/3)d (the digit keeps |w'| <= 2d/3) and
+    // m_k + 1 <= min (k - 1/3)d (the estimate is up to 2 units below the true 4w).
+    constexpr Srt4Table() : digit() {
+        for (int i = 0; i < 8; ++i) {
+            int lo = 8 + i, hi = 9 + i, m[5] = {};     // m[k + 2], k = -1..2
+            for (int k = -1; k <= 2; ++k) {
+                int a = (3 * k - 2) * (k >= 1 ? hi : lo);        // 3 * lower bound
+                int b = (3 * k - 1) * (k >= 1 ? lo : hi) - 3;    // 3 * upper bound
+                int mk = a >= 0 ? (a + 2) / 3 : -((-a) / 3);     // ceil(a / 3)
+                if (3 * mk > b) ok = 0;
+                m[k + 2] = mk;
+            }
+            for (int e = 0; e < 256; ++e) {
+                int y = e < 128 ? e : e - 256;
+                digit[i][e] = (int8_t)(y >= m[4] ? 2 : y >= m[3] ? 1 : y >= m[2] ? 0 : y >= m[1] ? -1 : -2);
+            }
+        }
+    }
+};
+constexpr Srt4Table kSrt4{};
+static_assert(kSrt4.ok, "SRT radix-4 selection table has no valid constants");
+
+// on-the-fly conversion: the two wires appended to Q and QM, and which register each starts from
+struct OnTheFly { int fromQM, q1, q0, mFromQM, m1, m0; };
+constexpr OnTheFly kOtf[5] = {
+    // q = -2: Q = 4QM + 2, QM = 4QM + 1
+    { 1, 1, 0, 1, 0, 1 },
+    // q = -1: Q = 4QM + 3, QM = 4QM + 2
+    { 1, 1, 1, 1, 1, 0 },
+    // q =  0: Q = 4Q + 0,  QM = 4QM + 3
+    { 0, 0, 0, 1, 1, 1 },
+    // q =  1: Q = 4Q + 1,  QM = 4Q + 0
+    { 0, 0, 1, 0, 0, 0 },
+    // q =  2: Q = 4Q + 2,  QM = 4Q + 1
+    { 0, 1, 0, 0, 0, 1 },
+};
+
+template <class Adder>
+struct Srt4Div {
+    static const char* name() { return "SRT radix-4"; }
+    static constexpr int kW = 40;   // remainder rows: |4w| < 8/3 * 2^32 plus sign, with room
+
+    template <bool Trace>
+    static int run(const Bits<32>& n, const Bits<32>& d, Bits<32>& q, Bits<32>& r, TraceRing* ring) {
+        int k = quotientBits(n, d);
+        if (!k) { q = Bits<32>{}; r = n; return 0; }
+        if constexpr (Trace) ring->begin(T_DIV_SRT4, traceWord(n), traceWord(d));
+        int s = leadingZeros(d);
+        int steps = (k + 2) / 2;                       // 4^steps >= 2^(k+1): the first w is below d/2
+
+        Bits<32> dn; wireShiftUp(d, s, dn);            // normalized divisor, wire 31 set
+        Bits<64> X; resizeBits(n, X); wireShiftUp(X, s, X);   // dividend scaled with it
+        Bits<kW> D1, D2, S, C, S4, C4, M, K;
+        resizeBits(dn, D1); wireShiftUp(D1, 1, D2);
+        takeBits(X, 2 * steps, S);                     // w0: the bits not yet fed in
+        Bits<3> sel; takeBits(dn, 28, sel);            // table row: the 3 wires below the leading 1
+
+        Bits<32> Q, QM = Q, t;                        // QM = Q - 1
+        for (int j = 0; j < Bits<32>::W; ++j) QM.w[j] = ~(uint64_t)0;
+        trimTop(QM);
+        for (int j = 2 * steps - 2; j >= 0; j -= 2) {
+            // 4w: both rows move up two wires; the next two dividend bits enter the sum row
+            wireShiftUp(S, 2, S4); S4.put(1, X.get(j + 1)); S4.put(0, X.get(j));
+            wireShiftUp(C, 2, C4);
+
+            // estimate: 8 wires at 2^28 (1/16 of the normalized divisor) from each row
+            Bits<8> es, ec, est; int c = 0;
+            takeBits(S4, 28, es); takeBits(C4, 28, ec);
+            Adder::add(es, ec, est, c);
+            int qd = kSrt4.digit[sel.w[0]][est.w[0]];
+
+            // -q*d as a third row: pick d or 2d, invert for q > 0 (+1 goes into the carry row)
+            const Bits<kW>& pick = (qd == 2 || qd == -2) ? D2 : D1;
+            uint64_t use = fanOut(qd != 0), inv = fanOut(qd > 0);
+            M.w[0] = ((pick.w[0] & use) ^ inv);
+            trimTop(M);
+            fullAdder(S4.w[0], C4.w[0], M.w[0], S.w[0], K.w[0]);
+            trimTop(S);
+            wireShiftUp(K, 1, C); C.put(0, qd > 0);
+
+            // on-the-fly quotient conversion (wiring only)
+            const OnTheFly& f = kOtf[qd + 2];
+            wireShiftUp(f.mFromQM ? QM : Q, 2, t); t.put(1, f.m1); t.put(0, f.m0);
+            wireShiftUp(f.fromQM ? QM : Q, 2, Q);  Q.put(1, f.q1); Q.put(0, f.q0);
+            QM = t;
+            if constexpr (Trace) ring->step(steps - 1 - j / 2, traceWord(S), traceWord(C), (uint32_t)traceWord(Q), qd);
+        }
+
+        // one carry-propagate add resolves the remainder; negative means q is one too big
+        Bits<kW> W; int c = 0;
+        Adder::add(S, C, W, c);
+        if (W.get(kW - 1)) { Q = QM; Adder::add(W, D1, W, c); }
+        q = Q;
+        takeBits(W, s, r);                             // undo the normalization
+        return steps;
+    }
+
+    static int divide(const Bits<32>& n, const Bits<32>& d, Bits<32>& q, Bits<32>& r, bool trace) {
+        if (TraceRing* ring = traceTarget(trace)) return run<true>(n, d, q, r, ring);
+        return run<false>(n, d, q, r, nullptr);
+    }
+};
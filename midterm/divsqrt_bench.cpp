@@ -0,0 +1,67 @@
+// divsqrt_bench.cpp - cost and speed of every Float32 divide / square-root engine, checked against host floats
+// Build: g++ -O2 -std=c++17 divsqrt_bench.cpp -o divsqrt_bench
+//        (-DMUL_ENGINE=... / -DDIV_ENGINE=... change the units the engines are built on)
+// Usage: divsqrt_bench [operations]
+// Columns are per operation averages: refinement steps or digits, MUL_ENGINE and DIV_ENGINE
+// calls, divider steps inside those calls, and +-1 fix-ups after the remainder check.
+#include "float_divsqrt.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+// finite nonzero operands; every 8th is subnormal
+static uint32_t operand(size_t i, bool positive){
+    uint32_t u = (uint32_t)rnd64();
+    if(i%8==3) u &= 0x807FFFFFu;
+    else if(((u>>23)&0xFF)==0xFF || ((u>>23)&0xFF)==0) u ^= 0x40000000u;
+    if(!(u&0x7FFFFFFFu)) u |= 1;
+    return positive ? u&0x7FFFFFFFu : u;
+}
+
+static uint32_t hostBits(float f){ uint32_t u; memcpy(&u,&f,4); return u; }
+
+template <class Engine>
+static void row(const vector<Bits<32>>& a, const vector<Bits<32>>& b, bool isSqrt){
+    size_t n = a.size();
+    vector<Bits<32>> r(n);
+    FpOpStats st;
+    auto t0 = chrono::steady_clock::now();
+    for(size_t i=0;i<n;++i){
+        if(isSqrt) Engine::sqrt(a[i], r[i], RoundingMode::RNE, &st);
+        else Engine::divide(a[i], b[i], r[i], RoundingMode::RNE, &st);
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / (double)n;
+    int bad = 0;
+    for(size_t i=0;i<n;++i){
+        float x = bitsToFloat(a[i]), y = bitsToFloat(b[i]);
+        uint32_t want = hostBits(isSqrt ? __builtin_sqrtf(x) : x / y);
+        if((uint32_t)r[i].w[0] != want) bad++;
+    }
+    double k = 1.0 / (double)n;
+    printf("%-18s %-5s %6.2f %6.2f %6.2f %7.2f %6.3f %9.1f %8.3f  %s\n", Engine::name(), isSqrt ? "sqrt" : "div",
+           st.iterations*k, st.multiplies*k, st.divides*k, st.divSteps*k, st.corrections*k, ns, 1000.0/ns, bad ? "MISMATCH" : "ok");
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 50000;
+    vector<Bits<32>> a(n), b(n), s(n);
+    for(size_t i=0;i<n;++i){
+        a[i] = intToBits((long long)operand(i, false));
+        b[i] = intToBits((long long)operand(i+5, false));
+        s[i] = intToBits((long long)operand(i, true));
+    }
+    printf("%zu operations per row, RNE; MUL engine %s, DIV engine %s, adder %s\n\n", n, MUL_ENGINE::name(), DIV_ENGINE::name(), FLOAT_ADDER::name());
+    printf("%-18s %-5s %6s %6s %6s %7s %6s %9s %8s  %s\n", "engine", "op", "iters", "mul", "div", "dsteps", "fixes", "ns/op", "Mop/s", "check");
+    row<NewtonRaphsonFp>(a, b, false);
+    row<GoldschmidtFp>(a, b, false);
+    row<DigitRecurrenceFp>(a, b, false);
+    row<NewtonRaphsonFp>(s, s, true);
+    row<GoldschmidtFp>(s, s, true);
+    row<DigitRecurrenceFp>(s, s, true);
+    return 0;
+}
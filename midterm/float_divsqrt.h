@@ -0,0 +1,331 @@
+// float_divsqrt.h - Float32 divide and square root on the bit-level multiplier and divider
+// Three engines share the special cases, operand normalization and final rounding:
+//   NewtonRaphsonFp    seed table + Newton-Raphson on the reciprocal / reciprocal square root
+//   GoldschmidtFp      seed table + Goldschmidt (the products of one step are independent)
+//   DigitRecurrenceFp  quotient digits from DIV_ENGINE (radix 256); square root bit by bit
+// The iterative engines end with one exact remainder check (a multiply and a subtract), so
+// results are correctly rounded however close the iteration got. floatDivide / floatSqrt use
+// FLOAT_DIV_ENGINE (selected in numeric_ops.h).
+#pragma once
+
+#include "numeric_ops.h"
+
+// ============================= Section 4b: Float32 Divide & Square Root (NO built-in + - * / % << >> on numeric types) =============================
+
+// What one operation cost (instrumentation, host ints).
+struct FpOpStats {
+    int iterations = 0;    // refinement steps / quotient digits / root bits
+    int multiplies = 0;    // MUL_ENGINE calls
+    int divides = 0;       // DIV_ENGINE calls
+    int divSteps = 0;      // steps the divider ran inside those calls
+    int corrections = 0;   // +-1 fix-ups after the remainder check
+};
+
+// ---------------- Seed tables ----------------
+// 128 entries of 9 significant bits (error below 2^-8), stored as Q1.31.
+// recip: index = the 7 fraction wires below the leading 1 of b in [1,2); 1/b at the interval midpoint.
+// rsqrt: index = wires 31..25 of x in Q2.30, x in [1,4); 1/sqrt(x) at the interval midpoint
+//        (entries below x = 1 are never read).
+struct FpSeedTables {
+    uint32_t recip[128];
+    uint32_t rsqrt[128];
+    constexpr FpSeedTables() : recip(), rsqrt() {
+        for (int i = 0; i < 128; ++i) {
+            uint64_t r = ((uint64_t)1 << 18) / (uint64_t)(257 + 2 * i);   // 2 * 2^17 / (midpoint * 2^8)
+            recip[i] = (uint32_t)((r + 1) / 2) << 22;
+            if (i < 32) continue;
+            uint64_t best = 0, bestErr = ~(uint64_t)0, target = (uint64_t)1 << 24;
+            for (uint64_t y = 256; y <= 512; ++y) {                       // y^2 * midpoint closest to 1
+                uint64_t v = y * y * (uint64_t)(2 * i + 1);
+                uint64_t err = v > target ? v - target : target - v;
+                if (err < bestErr) { bestErr = err; best = y; }
+            }
+            rsqrt[i] = (uint32_t)best << 22;
+        }
+    }
+};
+constexpr FpSeedTables kFpSeeds{};
+
+// ---------------- Shared pieces ----------------
+inline void addConst10(Bits<10>& e, int k) { int c = 0; FLOAT_ADDER::add(e, intToBits<10>(k), e, c); }
+
+// biased exponent and significand with wire 23 set: a subnormal's leading one is moved
+// up to wire 23 and the exponent lowered to match (down to -22)
+inline void unpackNormalized(const Float32& f, Bits<10>& e, Bits<24>& m) {
+    unpackSig(f, e, m);
+    Bits<5> lz = lzcTree(m);
+    barrelShift(m, lz, ShiftKind::Left, m);
+    Bits<10> n; resizeBits(lz, n); negateTwos<FLOAT_ADDER>(n, n); int c = 0; FLOAT_ADDER::add(e, n, e, c);
+}
+
+// fixed-point product: wires [lo, lo+31] of the 64-bit product
+inline void mulFix(const Bits<32>& a, const Bits<32>& b, int lo, Bits<32>& out, FpOpStats& st) {
+    Bits<64> p; MUL_ENGINE::multiply(a, 0, b, 0, p, false); st.multiplies++;
+    takeBits(p, lo, out);
+}
+
+// ---- divide ----
+// specials for a / b; returns 1 when out is final
+inline int divideSpecial(const Float32& A, const Float32& B, Bits<32>& out) {
+    FloatClass ca = classifyFloat32(A), cb = classifyFloat32(B);
+    int sign = A.sign ^ B.sign;
+    if (ca.nan || cb.nan || (ca.inf && cb.inf) || (ca.zero && cb.zero)) { canonicalNaN32(out); return 1; }
+    if (ca.inf || cb.zero) { signedInf32(sign, out); return 1; }
+    if (ca.zero || cb.inf) { signedZero32(sign, out); return 1; }
+    return 0;
+}
+
+// Finite nonzero operands, normalized. Every engine produces Qt = floor(mA * 2^27 / mB)
+// (27 or 28 wires) and whether the remainder is nonzero; exp is the biased exponent of
+// Qt wire 26.
+struct DivOperands { int sign; Bits<10> exp; Bits<24> mA, mB; };
+
+inline DivOperands divideOperands(const Float32& A, const Float32& B) {
+    DivOperands o; Bits<10> eA, eB, negEB;
+    o.sign = A.sign ^ B.sign;
+    unpackNormalized(A, eA, o.mA); unpackNormalized(B, eB, o.mB);
+    negateTwos<FLOAT_ADDER>(eB, negEB);
+    int c = 0; FLOAT_ADDER::add(eA, negEB, o.exp, c);
+    addConst10(o.exp, 126);
+    return o;
+}
+
+// exact check of an estimate: R = mA * 2^27 - Qt * mB, stepped until 0 <= R < mB
+inline void fixQuotient(Bits<32>& Qt, const DivOperands& o, int& inexact, FpOpStats& st) {
+    Bits<64> N, P, R, D, negD, t; Bits<32> b32;
+    resizeBits(o.mA, N); wireShiftUp(N, 27, N);
+    resizeBits(o.mB, b32);
+    MUL_ENGINE::multiply(Qt, 0, b32, 0, P, false); st.multiplies++;
+    int c = 0;
+    negateTwos<FLOAT_ADDER>(P, P); FLOAT_ADDER::add(N, P, R, c);
+    resizeBits(o.mB, D); negateTwos<FLOAT_ADDER>(D, negD);
+    while (R.get(63)) { FLOAT_ADDER::add(R, D, R, c); FLOAT_ADDER::add(Qt, ones<32>(), Qt, c); st.corrections++; }
+    for (;;) {
+        FLOAT_ADDER::add(R, negD, t, c);
+        if (t.get(63)) break;
+        R = t; FLOAT_ADDER::add(Qt, intToBits(1), Qt, c); st.corrections++;
+    }
+    inexact = !isZeroBits(R);
+}
+
+inline void packQuotient(const DivOperands& o, const Bits<32>& Qt, int inexact, RoundingMode rm, Bits<32>& out) {
+    Bits<28> q; resizeBits(Qt, q);
+    Bits<10> exp = o.exp;
+    if (q.get(27)) { shiftRightJam(q, 1, q); addConst10(exp, 1); }
+    Bits<27> sig; resizeBits(q, sig);
+    if (inexact) sig.put(0, 1);
+    roundPack32(o.sign, exp, sig, rm, out);
+}
+
+// ---- square root ----
+// specials for sqrt(a): NaN and negative nonzero inputs are invalid; +-0 and +Inf pass through
+inline int sqrtSpecial(const Bits<32>& a, const Float32& A, Bits<32>& out) {
+    FloatClass ca = classifyFloat32(A);
+    if (ca.nan || (A.sign && !ca.zero)) { canonicalNaN32(out); return 1; }
+    if (ca.zero || ca.inf) { out = a; return 1; }
+    return 0;
+}
+
+// X = m * 2^p with p = 29 or 30 matching the exponent's parity, so X in [2^52, 2^54) and the
+// root S = floor(sqrt(X)) sits on wires 26..0. exp = (e + 156 - p) / 2 is the biased exponent
+// of S wire 26; x = X / 2^52 in Q2.30 is m routed up p - 22 wires (exact).
+struct SqrtOperand { int p; Bits<10> exp; Bits<24> m; Bits<32> x; };
+
+inline SqrtOperand sqrtOperand(const Float32& A) {
+    SqrtOperand o; Bits<10> e;
+    unpackNormalized(A, e, o.m);
+    o.p = e.get(0) ? 29 : 30;
+    o.exp = e; addConst10(o.exp, 156 - o.p);
+    shiftRight1Arithmetic(o.exp, o.exp);                 // even: halving is wiring
+    resizeBits(o.m, o.x); wireShiftUp(o.x, o.p - 22, o.x);
+    return o;
+}
+
+// exact check of an estimate: R = X - S^2, stepped until 0 <= R <= 2S
+inline void fixRoot(Bits<32>& S, const SqrtOperand& o, int& inexact, FpOpStats& st) {
+    Bits<64> X, P, R, T, t;
+    resizeBits(o.m, X); wireShiftUp(X, o.p, X);
+    MUL_ENGINE::multiply(S, 0, S, 0, P, false); st.multiplies++;
+    int c = 0;
+    negateTwos<FLOAT_ADDER>(P, P); FLOAT_ADDER::add(X, P, R, c);
+    while (R.get(63)) {                                  // (S-1)^2 = S^2 - (2(S-1) + 1)
+        FLOAT_ADDER::add(S, ones<32>(), S, c);
+        resizeBits(S, T); wireShiftUp(T, 1, T); T.put(0, 1);
+        FLOAT_ADDER::add(R, T, R, c); st.corrections++;
+    }
+    for (;;) {                                           // (S+1)^2 = S^2 + 2S + 1
+        resizeBits(S, T); wireShiftUp(T, 1, T); T.put(0, 1);
+        negateTwos<FLOAT_ADDER>(T, T); FLOAT_ADDER::add(R, T, t, c);
+        if (t.get(63)) break;
+        R = t; FLOAT_ADDER::add(S, intToBits(1), S, c); st.corrections++;
+    }
+    inexact = !isZeroBits(R);
+}
+
+inline void packRoot(const SqrtOperand& o, const Bits<32>& S, int inexact, RoundingMode rm, Bits<32>& out) {
+    Bits<27> sig; resizeBits(S, sig);
+    if (inexact) sig.put(0, 1);
+    roundPack32(0, o.exp, sig, rm, out);
+}
+
+// ---------------- Newton-Raphson ----------------
+// Reciprocal: y' = y (2 - b y), two multiplies per step; 2 - t is the two's complement of t
+// in Q1.31 (mod 2). Reciprocal square root: y' = y (3 - x y^2) / 2, three multiplies per step.
+// Two steps take the 8-bit seed past 28 bits; one more multiply gives a/b or x*(1/sqrt x).
+struct NewtonRaphsonFp {
+    static const char* name() { return "Newton-Raphson"; }
+    static constexpr int kSteps = 2;
+
+    static void divide(const Bits<32>& a, const Bits<32>& b, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a), B = decodeFloat32(b);
+        if (divideSpecial(A, B, out)) return;
+        DivOperands o = divideOperands(A, B);
+        Bits<32> fa, fb, y, t;                           // Q1.31
+        resizeBits(o.mA, fa); wireShiftUp(fa, 8, fa);
+        resizeBits(o.mB, fb); wireShiftUp(fb, 8, fb);
+        Bits<7> idx; takeBits(fb, 24, idx);
+        y.w[0] = kFpSeeds.recip[busIndex(idx)];
+        for (int i = 0; i < kSteps; ++i, st.iterations++) {
+            mulFix(fb, y, 31, t, st);                    // b y ~ 1
+            negateTwos<FLOAT_ADDER>(t, t);               // 2 - b y
+            mulFix(y, t, 31, y, st);
+        }
+        Bits<32> q; mulFix(fa, y, 31, q, st);            // a / b in Q1.31
+        Bits<32> Qt; wireShiftDown(q, 4, Qt);
+        int inexact; fixQuotient(Qt, o, inexact, st);
+        packQuotient(o, Qt, inexact, rm, out);
+    }
+
+    static void sqrt(const Bits<32>& a, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a);
+        if (sqrtSpecial(a, A, out)) return;
+        SqrtOperand o = sqrtOperand(A);
+        Bits<7> idx; takeBits(o.x, 25, idx);
+        Bits<32> y, t, three; y.w[0] = kFpSeeds.rsqrt[busIndex(idx)];
+        three.put(31, 1); three.put(30, 1);              // 3 in Q2.30
+        for (int i = 0; i < kSteps; ++i, st.iterations++) {
+            mulFix(y, y, 31, t, st);                     // y^2      Q1.31
+            mulFix(o.x, t, 31, t, st);                   // x y^2    Q2.30, ~1
+            negateTwos<FLOAT_ADDER>(t, t);
+            int c = 0; FLOAT_ADDER::add(three, t, t, c); // 3 - x y^2
+            mulFix(y, t, 31, y, st);                     // y (3 - x y^2) in Q2.30 = half of it in Q1.31
+        }
+        Bits<32> s; mulFix(o.x, y, 31, s, st);           // sqrt(x) in Q2.30
+        Bits<32> S; wireShiftDown(s, 4, S);
+        int inexact; fixRoot(S, o, inexact, st);
+        packRoot(o, S, inexact, rm, out);
+    }
+};
+
+// ---------------- Goldschmidt ----------------
+// Divide: N = a y0, D = b y0, then N *= F, D *= F with F = 2 - D; N -> a/b as D -> 1.
+// Square root: g = x y0, h = x y0^2, then r = (3 - h) / 2, g *= r, h *= r^2; g -> sqrt(x)
+// as h -> 1. The products inside a step do not depend on each other (parallel multipliers);
+// here they run one after another.
+struct GoldschmidtFp {
+    static const char* name() { return "Goldschmidt"; }
+    static constexpr int kSteps = 2;
+
+    static void divide(const Bits<32>& a, const Bits<32>& b, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a), B = decodeFloat32(b);
+        if (divideSpecial(A, B, out)) return;
+        DivOperands o = divideOperands(A, B);
+        Bits<32> fa, fb, y, N, D, F;                     // Q1.31
+        resizeBits(o.mA, fa); wireShiftUp(fa, 8, fa);
+        resizeBits(o.mB, fb); wireShiftUp(fb, 8, fb);
+        Bits<7> idx; takeBits(fb, 24, idx);
+        y.w[0] = kFpSeeds.recip[busIndex(idx)];
+        mulFix(fa, y, 31, N, st);
+        mulFix(fb, y, 31, D, st);
+        for (int i = 0; i < kSteps; ++i, st.iterations++) {
+            negateTwos<FLOAT_ADDER>(D, F);               // 2 - D
+            mulFix(N, F, 31, N, st);
+            mulFix(D, F, 31, D, st);
+        }
+        Bits<32> Qt; wireShiftDown(N, 4, Qt);
+        int inexact; fixQuotient(Qt, o, inexact, st);
+        packQuotient(o, Qt, inexact, rm, out);
+    }
+
+    static void sqrt(const Bits<32>& a, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a);
+        if (sqrtSpecial(a, A, out)) return;
+        SqrtOperand o = sqrtOperand(A);
+        Bits<7> idx; takeBits(o.x, 25, idx);
+        Bits<32> y, t, g, h, r, three; y.w[0] = kFpSeeds.rsqrt[busIndex(idx)];
+        three.put(31, 1); three.put(30, 1);              // 3 in Q2.30
+        mulFix(y, y, 31, t, st);                         // y0^2      Q1.31
+        mulFix(o.x, t, 31, h, st);                       // x y0^2    Q2.30, ~1
+        mulFix(o.x, y, 31, g, st);                       // x y0      Q2.30, ~sqrt(x)
+        for (int i = 0; i < kSteps; ++i, st.iterations++) {
+            negateTwos<FLOAT_ADDER>(h, r);
+            int c = 0; FLOAT_ADDER::add(three, r, r, c); // 3 - h in Q2.30 = (3 - h) / 2 in Q1.31
+            mulFix(g, r, 31, g, st);
+            mulFix(r, r, 31, t, st);
+            mulFix(h, t, 31, h, st);
+        }
+        Bits<32> S; wireShiftDown(g, 4, S);
+        int inexact; fixRoot(S, o, inexact, st);
+        packRoot(o, S, inexact, rm, out);
+    }
+};
+
+// ---------------- Digit recurrence ----------------
+// Divide: radix-256 long division on DIV_ENGINE. The remainder stays below mB < 2^24, so
+// remainder * 2^8 fits the 32-bit dividend; four calls bring down 8 + 8 + 8 + 3 = 27 wires.
+// Each digit is at most 9 bits, so the early-terminating engines stop after a few steps.
+// Square root: restoring, one root bit per step: R = 4R + next two wires of X, and the trial
+// subtract of 4S + 1 is an add of ~(4S) (two's complement of 4S + 1 with no carry chain).
+struct DigitRecurrenceFp {
+    static const char* name() { return "digit recurrence"; }
+
+    static void divide(const Bits<32>& a, const Bits<32>& b, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a), B = decodeFloat32(b);
+        if (divideSpecial(A, B, out)) return;
+        DivOperands o = divideOperands(A, B);
+        static const int kShift[4] = { 8, 8, 8, 3 };    // wires brought down per digit: 27 in all
+        Bits<32> d, n, q, r, Qt;
+        resizeBits(o.mB, d);
+        resizeBits(o.mA, r);
+        for (int i = 0; i < 4; ++i, st.iterations++) {
+            wireShiftUp(r, kShift[i], n);
+            st.divSteps += DIV_ENGINE::divide(n, d, q, r, false); st.divides++;
+            wireShiftUp(Qt, kShift[i], Qt);
+            for (int j = 0; j < Bits<32>::W; ++j) Qt.w[j] |= q.w[j];   // digit fills the wires just opened
+        }
+        packQuotient(o, Qt, !isZeroBits(r), rm, out);
+    }
+
+    static void sqrt(const Bits<32>& a, Bits<32>& out, RoundingMode rm, FpOpStats* stats) {
+        FpOpStats none; FpOpStats& st = stats ? *stats : none;
+        Float32 A = decodeFloat32(a);
+        if (sqrtSpecial(a, A, out)) return;
+        SqrtOperand o = sqrtOperand(A);
+        Bits<64> X; resizeBits(o.m, X); wireShiftUp(X, o.p, X);
+        Bits<32> S, R, R4, T, D;                         // R <= 2S < 2^28: 4R + 3 stays positive in 32 wires
+        for (int i = 26; i >= 0; --i, st.iterations++) {
+            wireShiftUp(R, 2, R4); R4.put(1, X.get(2 * i + 1)); R4.put(0, X.get(2 * i));
+            wireShiftUp(S, 2, T);
+            for (int j = 0; j < Bits<32>::W; ++j) T.w[j] = ~T.w[j];   // -(4S + 1)
+            trimTop(T);
+            int c = 0; FLOAT_ADDER::add(R4, T, D, c);
+            int bit = !D.get(31);
+            R = bit ? D : R4;
+            wireShiftUp(S, 1, S); S.put(0, bit);
+        }
+        packRoot(o, S, !isZeroBits(R), rm, out);
+    }
+};
+
+// ---------------- Unit entry points ----------------
+inline void floatDivide(const Bits<32>& a, const Bits<32>& b, Bits<32>& out, RoundingMode rm = RoundingMode::RNE) {
+    FLOAT_DIV_ENGINE::divide(a, b, out, rm, nullptr);
+}
+inline void floatSqrt(const Bits<32>& a, Bits<32>& out, RoundingMode rm = RoundingMode::RNE) {
+    FLOAT_DIV_ENGINE::sqrt(a, out, rm, nullptr);
+}
@@ -0,0 +1,394 @@
+// float_formats.h - format-templated IEEE-754 engine: binary16, bfloat16, binary32, binary64
+// One add/sub, multiply and round-and-pack per IeeeFormat<E, F> (E exponent wires, F fraction
+// wires), conversions between any two formats, and bit-sliced batch conversion kernels
+// (256 values per pass, bitslice.h). The Float32 units in numeric_ops.h stay the reference;
+// format_bench.cpp cross-checks binary32 here against them bit for bit.
+// Same conventions as the Float32 units: the five RISC-V rounding modes, the canonical quiet
+// NaN for every NaN result, exponents on a signed bus of E + 2 wires through FLOAT_ADDER,
+// alignment and normalization on the barrel shifter.
+#pragma once
+
+#include "bitslice.h"
+#include "wide_ops.h"
+
+// ============================= Formats =============================
+template <int E, int F>
+struct IeeeFormat {
+    static constexpr int kExp = E, kFrac = F;
+    static constexpr int kWidth = 1 + E + F;
+    static constexpr int kBias = (1 << (E - 1)) - 1;   // format constant, not a modeled value
+    static constexpr int kBus = E + 2;                  // signed exponent bus
+};
+
+struct Binary16 : IeeeFormat<5, 10> { static const char* name() { return "binary16"; } };
+struct BFloat16 : IeeeFormat<8, 7>  { static const char* name() { return "bfloat16"; } };
+struct Binary32 : IeeeFormat<8, 23> { static const char* name() { return "binary32"; } };
+struct Binary64 : IeeeFormat<11, 52> { static const char* name() { return "binary64"; } };
+
+template <class Fmt> using FloatWord = Bits<Fmt::kWidth>;
+
+// ============================= Section 1: Core Implementation (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---------------- Representation ----------------
+template <class Fmt>
+struct FloatFields {
+    int sign;
+    Bits<Fmt::kExp> exponent;
+    Bits<Fmt::kFrac> fraction;
+};
+
+template <class Fmt>
+inline FloatFields<Fmt> decodeFloat(const FloatWord<Fmt>& bits) {
+    FloatFields<Fmt> f;
+    f.sign = bits.get(Fmt::kWidth - 1);
+    takeBits(bits, Fmt::kFrac, f.exponent);
+    takeBits(bits, 0, f.fraction);
+    return f;
+}
+
+template <class Fmt>
+inline void encodeFloat(const FloatFields<Fmt>& f, FloatWord<Fmt>& bits) {
+    bits = zeros<Fmt::kWidth>();
+    placeBits(f.exponent, Fmt::kFrac, bits);
+    placeBits(f.fraction, 0, bits);
+    bits.put(Fmt::kWidth - 1, f.sign);
+}
+
+template <class Fmt>
+inline FloatClass classifyFloat(const FloatFields<Fmt>& f) {
+    int eZero = isZeroBits(f.exponent), eOnes = sameBits(f.exponent, ones<Fmt::kExp>()), fZero = isZeroBits(f.fraction);
+    return { eZero & fZero, eZero & !fZero, eOnes & fZero, eOnes & !fZero };
+}
+
+template <class Fmt>
+inline void canonicalNaN(FloatWord<Fmt>& out) { out = zeros<Fmt::kWidth>(); placeBits(ones<Fmt::kExp + 1>(), Fmt::kFrac - 1, out); }
+template <class Fmt>
+inline void signedInf(int sign, FloatWord<Fmt>& out) { out = zeros<Fmt::kWidth>(); placeBits(ones<Fmt::kExp>(), Fmt::kFrac, out); out.put(Fmt::kWidth - 1, sign); }
+template <class Fmt>
+inline void signedZero(int sign, FloatWord<Fmt>& out) { out = zeros<Fmt::kWidth>(); out.put(Fmt::kWidth - 1, sign); }
+
+// biased exponent on the bus (subnormals use exponent 1) and the F+1-wire significand
+template <class Fmt, int EB>
+inline void unpackSigF(const FloatFields<Fmt>& f, Bits<EB>& e, Bits<Fmt::kFrac + 1>& m) {
+    int sub = isZeroBits(f.exponent);
+    resizeBits(f.exponent, e); if (sub) e.put(0, 1);
+    resizeBits(f.fraction, m); m.put(Fmt::kFrac, !sub);
+}
+
+// ---------------- Rounding ----------------
+// increment decision from guard, round, sticky and the kept LSB
+inline int roundIncrement(int sign, int g, int r, int s, int lsb, RoundingMode rm) {
+    int inexact = g | r | s;
+    return rm == RoundingMode::RNE ? g & (r | s | lsb)
+         : rm == RoundingMode::RDN ? sign & inexact
+         : rm == RoundingMode::RUP ? (!sign) & inexact
+         : rm == RoundingMode::RMM ? g : 0;
+}
+
+// overflow: Inf, or the largest finite value when the mode rounds toward zero for this sign
+template <class Fmt>
+inline void overflowF(int sign, RoundingMode rm, FloatWord<Fmt>& out) {
+    int toInf = rm == RoundingMode::RNE || rm == RoundingMode::RMM ||
+                (rm == RoundingMode::RUP && !sign) || (rm == RoundingMode::RDN && sign);
+    if (toInf) { signedInf<Fmt>(sign, out); return; }
+    Bits<Fmt::kWidth - 1> maxFinite = ones<Fmt::kWidth - 1>(); maxFinite.put(Fmt::kFrac, 0);
+    resizeBits(maxFinite, out); out.put(Fmt::kWidth - 1, sign);
+}
+
+// Round and pack, as roundPack32: exp = biased exponent (any bus wider than E) of wire F+3 of
+// sig; wires 2,1,0 are guard, round and sticky. Either wire F+3 is 1, or exp is 1 (subnormal
+// range), or exp <= 0 and sig is shifted down into the subnormal range here.
+template <class Fmt, int EB>
+inline void roundPackF(int sign, Bits<EB> exp, Bits<Fmt::kFrac + 4> sig, RoundingMode rm, FloatWord<Fmt>& out) {
+    constexpr int E = Fmt::kExp, F = Fmt::kFrac;
+    static_assert(EB > E, "the exponent bus needs a wire above the field");
+    int c = 0;
+    if (signBit(exp) || isZeroBits(exp)) {
+        Bits<EB> k; negateTwos<FLOAT_ADDER>(exp, k);
+        FLOAT_ADDER::add(k, intToBits<EB>(1), k, c);         // 1 - exp
+        barrelShiftRightJam(sig, k, sig);
+        exp = intToBits<EB>(1);                              // packed field becomes 0
+    } else {
+        Bits<EB - E> high; takeBits(exp, E, high);
+        if (!isZeroBits(high)) { overflowF<Fmt>(sign, rm, out); return; }   // exp >= 2^E
+    }
+    Bits<E> field; takeBits(exp, 0, field);
+    if (sameBits(field, ones<E>())) { overflowF<Fmt>(sign, rm, out); return; }
+
+    int inc = roundIncrement(sign, sig.get(2), sig.get(1), sig.get(0), sig.get(3), rm);
+
+    // {exp - 1, 0...} + {hidden, fraction}: the hidden bit lands in the exponent field
+    Bits<EB> em1; FLOAT_ADDER::add(exp, intToBits<EB>(-1), em1, c);
+    takeBits(em1, 0, field);
+    Bits<Fmt::kWidth - 1> packed, sf, one;
+    placeBits(field, F, packed);
+    Bits<F + 1> kept; takeBits(sig, 3, kept); resizeBits(kept, sf);
+    FLOAT_ADDER::add(packed, sf, packed, c);
+    one.put(0, inc);
+    FLOAT_ADDER::add(packed, one, packed, c);
+    Bits<E> outExp; takeBits(packed, F, outExp);
+    if (sameBits(outExp, ones<E>())) { overflowF<Fmt>(sign, rm, out); return; }
+    resizeBits(packed, out); out.put(Fmt::kWidth - 1, sign);
+}
+
+// ---------------- Addition/Subtraction ----------------
+// floatAddSub for any format: align with guard/round/sticky wires, add or subtract,
+// normalize by the leading-zero count (stopping at the subnormal exponent), round.
+template <class Fmt>
+inline void floatAddSubF(const FloatWord<Fmt>& a, const FloatWord<Fmt>& b, bool subtract, FloatWord<Fmt>& out,
+                         RoundingMode rm = RoundingMode::RNE) {
+    constexpr int F = Fmt::kFrac, EB = Fmt::kBus, MW = F + 5;   // carry, hidden, F fraction, G R S
+    FloatFields<Fmt> A = decodeFloat<Fmt>(a);
+    FloatFields<Fmt> B = decodeFloat<Fmt>(b);
+    B.sign ^= subtract;
+    FloatClass ca = classifyFloat(A), cb = classifyFloat(B);
+    if (ca.nan || cb.nan) { canonicalNaN<Fmt>(out); return; }
+    if (ca.inf || cb.inf) {
+        if (ca.inf && cb.inf && A.sign != B.sign) { canonicalNaN<Fmt>(out); return; }   // Inf - Inf
+        signedInf<Fmt>(ca.inf ? A.sign : B.sign, out); return;
+    }
+
+    // order by magnitude: X is the larger, its exponent leads
+    Bits<Fmt::kWidth - 1> magA, magB; takeBits(a, 0, magA); takeBits(b, 0, magB);
+    if (uCmp(magA, magB) < 0) swap(A, B);
+
+    Bits<EB> eX, eY; Bits<F + 1> sX, sY;
+    unpackSigF(A, eX, sX); unpackSigF(B, eY, sY);
+    Bits<MW> mX, mY;
+    resizeBits(sX, mX); wireShiftUp(mX, 3, mX);
+    resizeBits(sY, mY); wireShiftUp(mY, 3, mY);
+
+    int c = 0;
+    Bits<EB> negEY, diff; negateTwos<FLOAT_ADDER>(eY, negEY);
+    FLOAT_ADDER::add(eX, negEY, diff, c);                // >= 0
+    barrelShiftRightJam(mY, diff, mY);
+
+    Bits<MW> sum;
+    int effSub = A.sign ^ B.sign;
+    if (effSub) { Bits<MW> negY; negateTwos<FLOAT_ADDER>(mY, negY); FLOAT_ADDER::add(mX, negY, sum, c); }
+    else FLOAT_ADDER::add(mX, mY, sum, c);
+
+    if (isZeroBits(sum)) { signedZero<Fmt>(effSub ? rm == RoundingMode::RDN : A.sign, out); return; }
+
+    Bits<EB> exp = eX;
+    Bits<F + 4> sig;
+    if (sum.get(MW - 1)) {                               // carry out: one wire down, exponent + 1
+        shiftRightJam(sum, 1, sum);
+        FLOAT_ADDER::add(exp, intToBits<EB>(1), exp, c);
+        takeBits(sum, 0, sig);
+    } else {
+        takeBits(sum, 0, sig);
+        Bits<EB> room; FLOAT_ADDER::add(exp, intToBits<EB>(-1), room, c);   // shifts left before subnormal
+        Bits<EB> lz, sh, negSh; resizeBits(lzcTree(sig), lz);
+        sh = uCmp(lz, room) < 0 ? lz : room;
+        barrelShift(sig, sh, ShiftKind::Left, sig);
+        negateTwos<FLOAT_ADDER>(sh, negSh);
+        FLOAT_ADDER::add(exp, negSh, exp, c);
+    }
+    roundPackF<Fmt>(A.sign, exp, sig, rm, out);
+}
+
+// ---------------- Multiplication ----------------
+// Significands up to 32 wires multiply on MUL_ENGINE; wider ones (binary64) on the wide
+// multiplier (wide_ops.h), whose limb products go through MUL_ENGINE as well.
+template <int S>
+inline void significandProduct(const Bits<S>& a, const Bits<S>& b, Bits<2 * S>& p) {
+    if constexpr (S <= 32) {
+        Bits<32> a32, b32; zeroExtend(a, a32); zeroExtend(b, b32);
+        Bits<64> prod; MUL_ENGINE::multiply(a32, 0, b32, 0, prod, false);
+        resizeBits(prod, p);
+    } else {
+        constexpr int L = (S + 31) / 32 * 32;
+        Bits<L> aw, bw; zeroExtend(a, aw); zeroExtend(b, bw);
+        Bits<2 * L> prod; mulWide(aw, bw, prod);
+        resizeBits(prod, p);
+    }
+}
+
+template <class Fmt>
+inline void floatMultiplyF(const FloatWord<Fmt>& a, const FloatWord<Fmt>& b, FloatWord<Fmt>& out,
+                           RoundingMode rm = RoundingMode::RNE) {
+    constexpr int F = Fmt::kFrac, EB = Fmt::kBus, P = 2 * F + 2;
+    FloatFields<Fmt> A = decodeFloat<Fmt>(a);
+    FloatFields<Fmt> B = decodeFloat<Fmt>(b);
+    int resultSign = A.sign ^ B.sign;
+    FloatClass ca = classifyFloat(A), cb = classifyFloat(B);
+    if (ca.nan || cb.nan || (ca.inf && cb.zero) || (ca.zero && cb.inf)) { canonicalNaN<Fmt>(out); return; }
+    if (ca.inf || cb.inf) { signedInf<Fmt>(resultSign, out); return; }
+    if (ca.zero || cb.zero) { signedZero<Fmt>(resultSign, out); return; }
+
+    Bits<EB> eA, eB, exp; Bits<F + 1> mA, mB;
+    unpackSigF(A, eA, mA); unpackSigF(B, eB, mB);
+    int c = 0;
+    FLOAT_ADDER::add(eA, eB, exp, c);
+    FLOAT_ADDER::add(exp, intToBits<EB>(1 - Fmt::kBias), exp, c);   // - bias, + 1 for a leading 1 at wire P-1
+
+    Bits<P> p; significandProduct(mA, mB, p);
+    auto lz = lzcTree(p);                                // nonzero operands: lz <= P-2
+    barrelShift(p, lz, ShiftKind::Left, p);
+    Bits<EB> negLz; resizeBits(lz, negLz); negateTwos<FLOAT_ADDER>(negLz, negLz);
+    FLOAT_ADDER::add(exp, negLz, exp, c);
+    Bits<P> low; wireShiftUp(p, F + 4, low);             // the wires below the kept F+4
+    Bits<F + 4> sig; takeBits(p, P - (F + 4), sig);
+    if (!isZeroBits(low)) sig.put(0, 1);
+    roundPackF<Fmt>(resultSign, exp, sig, rm, out);
+}
+
+// ---------------- Conversion ----------------
+// Any format to any other: rebias on a bus wide enough for both, bring a subnormal's leading 1
+// to the top, then round into the target (exact when the target is wider). NaN in -> canonical NaN.
+template <class From, class To>
+inline void convertFloat(const FloatWord<From>& a, FloatWord<To>& out, RoundingMode rm = RoundingMode::RNE) {
+    constexpr int EB = (From::kExp > To::kExp ? From::kExp : To::kExp) + 2;
+    constexpr int SF = From::kFrac + 1, ST = To::kFrac + 4, CW = SF > ST ? SF : ST;
+    FloatFields<From> A = decodeFloat<From>(a);
+    FloatClass ca = classifyFloat(A);
+    if (ca.nan) { canonicalNaN<To>(out); return; }
+    if (ca.inf) { signedInf<To>(A.sign, out); return; }
+    if (ca.zero) { signedZero<To>(A.sign, out); return; }
+
+    Bits<EB> e; Bits<SF> m;
+    unpackSigF(A, e, m);
+    int c = 0;
+    FLOAT_ADDER::add(e, intToBits<EB>(To::kBias - From::kBias), e, c);
+    auto lz = lzcTree(m);                                // 0 unless subnormal
+    barrelShift(m, lz, ShiftKind::Left, m);
+    Bits<EB> negLz; resizeBits(lz, negLz); negateTwos<FLOAT_ADDER>(negLz, negLz);
+    FLOAT_ADDER::add(e, negLz, e, c);
+    Bits<CW> t; resizeBits(m, t); wireShiftUp(t, CW - SF, t);
+    shiftRightJam(t, CW - ST, t);
+    Bits<ST> sig; resizeBits(t, sig);
+    roundPackF<To>(A.sign, e, sig, rm, out);
+}
+
+// ============================= Bit-sliced batch conversion =============================
+// The same conversion as a gate circuit over 256 lanes (bitslice.h): the per-lane shifts
+// (subnormal normalize, subnormal denormalize) are log2 stages of 2:1 multiplexers, the
+// leading-zero count falls out of the normalize stages, and all adds ripple per plane.
+template <int N>
+inline SlicedBits<N> sliceConst(long long v) {
+    Bits<N> x = intToBits<N>(v);
+    SlicedBits<N> s;
+    for (int p = 0; p < N; ++p) s.b[p] = x.get(p) ? Lane256::ones() : Lane256::zero();
+    return s;
+}
+
+// per-lane increment decision (rm is one control value for the whole pass)
+inline Lane256 sliceRoundIncrement(Lane256 sign, Lane256 g, Lane256 r, Lane256 s, Lane256 lsb, RoundingMode rm) {
+    Lane256 inexact = g | r | s;
+    switch (rm) {
+        case RoundingMode::RNE: return g & (r | s | lsb);
+        case RoundingMode::RDN: return sign & inexact;
+        case RoundingMode::RUP: return andNot(sign, inexact);
+        case RoundingMode::RMM: return g;
+        default: return Lane256::zero();
+    }
+}
+
+template <class From, class To>
+inline void sliceConvertFloat(const SlicedBits<From::kWidth>& a, RoundingMode rm, SlicedBits<To::kWidth>& out) {
+    constexpr int EF = From::kExp, FF = From::kFrac, ET = To::kExp, FT = To::kFrac, WT = To::kWidth;
+    constexpr int EB = (EF > ET ? EF : ET) + 2;
+    constexpr int SF = FF + 1, ST = FT + 4, CW = SF > ST ? SF : ST;
+    const Lane256 Z = Lane256::zero(), O = Lane256::ones();
+    Lane256 c;
+
+    // ---- classify ----
+    Lane256 sign = a.b[From::kWidth - 1], eAny = Z, eAll = O, fAny = Z;
+    for (int p = 0; p < EF; ++p) { eAny = eAny | a.b[FF + p]; eAll = eAll & a.b[FF + p]; }
+    for (int p = 0; p < FF; ++p) fAny = fAny | a.b[p];
+    Lane256 nan = eAll & fAny, inf = andNot(fAny, eAll), zero = ~(eAny | fAny);
+
+    // ---- unpack: exponent bus (subnormals use 1) and significand with the hidden bit ----
+    SlicedBits<EB> e;
+    for (int p = 0; p < EB; ++p) e.b[p] = p < EF ? a.b[FF + p] : Z;
+    e.b[0] = e.b[0] | andNot(eAny, fAny);
+    SlicedBits<SF> m;
+    for (int p = 0; p < FF; ++p) m.b[p] = a.b[p];
+    m.b[FF] = eAny;
+
+    // ---- normalize: a stage of s wires shifts when the top s wires are all zero ----
+    SlicedBits<EB> lz = sliceConst<EB>(0);
+    int top = 1, bit = 0;
+    while (top + top <= FF) { top += top; ++bit; }
+    for (int s = top; s >= 1; s /= 2, --bit) {
+        Lane256 any = Z;
+        for (int p = SF - s; p < SF; ++p) any = any | m.b[p];
+        Lane256 z = ~any;
+        for (int p = SF - 1; p >= 0; --p) m.b[p] = select(z, p >= s ? m.b[p - s] : Z, m.b[p]);
+        lz.b[bit] = z;
+    }
+    SlicedBits<EB> t;
+    sliceNegate(lz, t); sliceAdd(e, t, e, c);
+    sliceAdd(e, sliceConst<EB>(To::kBias - From::kBias), e, c);
+
+    // ---- significand to the target's F+4 wires: top aligned, wires below jammed into sticky ----
+    SlicedBits<ST> sig;
+    Lane256 sticky = Z;
+    for (int p = 0; p < CW - ST; ++p) sticky = sticky | (p >= CW - SF ? m.b[p - (CW - SF)] : Z);
+    for (int j = 0; j < ST; ++j) { int p = j + CW - ST; sig.b[j] = p >= CW - SF ? m.b[p - (CW - SF)] : Z; }
+    sig.b[0] = sig.b[0] | sticky;
+
+    // ---- subnormal result: exp <= 0 shifts right by 1 - exp with sticky, exp becomes 1 ----
+    Lane256 under = e.b[EB - 1] | sliceIsZero(e);
+    SlicedBits<EB> k;
+    sliceNegate(e, k); sliceAdd(k, sliceConst<EB>(1), k, c);
+    int L = 0;
+    while ((1 << L) < ST) ++L;
+    Lane256 big = Z;
+    for (int p = L; p < EB; ++p) big = big | k.b[p];
+    for (int j = 0; j < L; ++j) {
+        int s = 1 << j;
+        Lane256 mj = under & k.b[j], lost = Z;
+        for (int p = 0; p < s && p < ST; ++p) lost = lost | sig.b[p];
+        for (int p = 0; p < ST; ++p) sig.b[p] = select(mj, p + s < ST ? sig.b[p + s] : Z, sig.b[p]);
+        sig.b[0] = sig.b[0] | (mj & lost);
+    }
+    Lane256 flush = under & big, anySig = ~sliceIsZero(sig);
+    for (int p = 0; p < ST; ++p) sig.b[p] = andNot(flush, sig.b[p]);
+    sig.b[0] = sig.b[0] | (flush & anySig);
+    sliceSelect(under, sliceConst<EB>(1), e, e);
+
+    // ---- overflow before rounding: exp >= 2^E - 1 ----
+    Lane256 high = Z, fieldOnes = O;
+    for (int p = ET; p < EB; ++p) high = high | e.b[p];
+    for (int p = 0; p < ET; ++p) fieldOnes = fieldOnes & e.b[p];
+    Lane256 ovf = andNot(under, high | fieldOnes);
+
+    // ---- round and pack: {exp - 1, 0...} + {hidden, fraction} + inc ----
+    Lane256 inc = sliceRoundIncrement(sign, sig.b[2], sig.b[1], sig.b[0], sig.b[3], rm);
+    SlicedBits<EB> em1; sliceAdd(e, sliceConst<EB>(-1), em1, c);
+    SlicedBits<WT - 1> P, S;
+    for (int p = 0; p < WT - 1; ++p) { P.b[p] = p >= FT ? em1.b[p - FT] : Z; S.b[p] = p <= FT ? sig.b[p + 3] : Z; }
+    sliceAdd(P, S, P, c);
+    for (int p = 0; p < WT - 1; ++p) { Lane256 s = P.b[p] ^ inc; inc = P.b[p] & inc; P.b[p] = s; }
+    Lane256 expOnes = O;
+    for (int p = FT; p < WT - 1; ++p) expOnes = expOnes & P.b[p];
+    ovf = ovf | expOnes;
+
+    // ---- overflow value, then the special classes ----
+    Lane256 toInf = rm == RoundingMode::RNE || rm == RoundingMode::RMM ? O
+                  : rm == RoundingMode::RUP ? ~sign : rm == RoundingMode::RDN ? sign : Z;
+    for (int p = 0; p < WT - 1; ++p) {
+        Lane256 r = select(ovf, p > FT ? O : p == FT ? toInf : ~toInf, P.b[p]);   // Inf or max finite
+        r = andNot(zero, r);
+        r = select(inf, p >= FT ? O : Z, r);
+        out.b[p] = select(nan, p >= FT - 1 ? O : Z, r);
+    }
+    out.b[WT - 1] = andNot(nan, sign);
+}
+
+// ============================= Batch API over plain Bits arrays =============================
+// 'count' conversions, 256 per pass; the same results convertFloat would give one at a time.
+template <class From, class To>
+inline void convertFloatBatch(const FloatWord<From>* in, FloatWord<To>* out, size_t count,
+                              RoundingMode rm = RoundingMode::RNE) {
+    for (size_t base = 0; base < count; base += kSliceLanes) {
+        size_t n = count - base < (size_t)kSliceLanes ? count - base : (size_t)kSliceLanes;
+        SlicedBits<From::kWidth> A;
+        SlicedBits<To::kWidth> R;
+        sliceIn(in + base, n, A);
+        sliceConvertFloat<From, To>(A, rm, R);
+        sliceOut(R, out + base, n);
+    }
+}
@@ -0,0 +1,279 @@
+// float_verify.cpp - IEEE-754 conformance harness for the Float32 units against host binary32
+// Build: g++ -O2 -std=c++17 -pthread -frounding-math float_verify.cpp -o float_verify
+//        (FLOAT_ADDER / MUL_ENGINE / DIV_ENGINE / FLOAT_DIV_ENGINE pick the parts under test)
+// Usage: float_verify [--ops add,sub,mul,div,sqrt] [--modes rne,rtz,rdn,rup,rmm] [--random N] [--seed S]
+//                     [--threads T] [--show K]
+//
+// Every (op, mode) pair runs two jobs:
+//   specials  the full cross product of +-{0, subnormals, normal edges, 1.0, max, Inf, qNaN, sNaN}
+//   random    N pairs mixing uniform bit patterns, close exponents (cancellation), subnormal-heavy
+//             operands, exponent sums near overflow/underflow, rounding-position ties and
+//             special-vs-random; pair i depends only on (seed, i)
+// Threads set the host rounding mode (fesetround) for each chunk. RMM has no host mode: its
+// reference is host RNE, moved away from zero when the exact result lies on a midpoint; the
+// result computed in double is exact whenever a tie is possible (and sqrt never ties).
+// sqrt ignores the second operand.
+// Results are compared bit for bit, except that any host NaN matches the unit's canonical NaN.
+// Mismatches are bucketed by ULP distance; the first K are printed.
+// Exit code: 0 all bit-exact, 1 mismatches, 2 usage error.
+#include "float_divsqrt.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfenv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================== Operations & host reference ==============================
+enum FOp { F_ADD, F_SUB, F_MUL, F_DIV, F_SQRT, F_OPS };
+static const char* kOpName[F_OPS] = { "add", "sub", "mul", "div", "sqrt" };
+
+static const char* kModeName[5] = { "rne", "rtz", "rdn", "rup", "rmm" };
+static const int kHostMode[5] = { FE_TONEAREST, FE_TOWARDZERO, FE_DOWNWARD, FE_UPWARD, FE_TONEAREST };
+
+static float asFloat(uint32_t u){ float f; memcpy(&f, &u, 4); return f; }
+static uint32_t asBits(float f){ uint32_t u; memcpy(&u, &f, 4); return u; }
+
+// the calling thread's rounding mode must already be kHostMode[mode]
+static uint32_t reference(FOp op, int mode, uint32_t a, uint32_t b){
+    volatile float x = asFloat(a), y = asFloat(b);
+    volatile float r = op==F_ADD ? x + y : op==F_SUB ? x - y : op==F_MUL ? x * y : op==F_DIV ? x / y : __builtin_sqrtf(x);
+    if(mode != (int)RoundingMode::RMM || !std::isfinite((float)r)) return asBits(r);
+    volatile double dx = x, dy = y;
+    volatile double d = op==F_ADD ? dx + dy : op==F_SUB ? dx - dy : op==F_MUL ? dx * dy : op==F_DIV ? dx / dy : __builtin_sqrt(dx);
+    if(d == (double)r) return asBits(r);
+    float n = nextafterf(r, d > (double)r ? INFINITY : -INFINITY);
+    if(!std::isfinite(n) || (double)r + (double)n != 2 * d) return asBits(r);   // not a tie
+    return asBits(fabsf(n) > fabsf(r) ? n : r);
+}
+
+static uint32_t unit(FOp op, int mode, uint32_t a, uint32_t b){
+    Bits<32> A = intToBits((long long)a), B = intToBits((long long)b), R;
+    RoundingMode rm = (RoundingMode)mode;
+    if(op==F_MUL) floatMultiply(A, B, R, rm);
+    else if(op==F_DIV) floatDivide(A, B, R, rm);
+    else if(op==F_SQRT) floatSqrt(A, R, rm);
+    else floatAddSub(A, B, op==F_SUB, R, rm);
+    return (uint32_t)R.w[0];
+}
+
+// ============================== ULP buckets ==============================
+enum Bucket { B_EXACT, B_1, B_2, B_4, B_16, B_256, B_FAR, B_CLASS, B_COUNT };
+static const char* kBucketName[B_COUNT] = { "exact", "1", "2", "3-4", "5-16", "17-256", ">256", "class" };
+
+static bool isNaN32(uint32_t u){ return (u & 0x7F800000u) == 0x7F800000u && (u & 0x007FFFFFu); }
+// monotone map of the float line onto the integers (+0 and -0 both map to 0)
+static int64_t ordered(uint32_t u){ return (u & 0x80000000u) ? -(int64_t)(u & 0x7FFFFFFFu) : (int64_t)u; }
+
+static Bucket classify(uint32_t want, uint32_t got, uint64_t& ulps){
+    ulps = 0;
+    if(isNaN32(want) || isNaN32(got)) return isNaN32(want) && got == 0x7FC00000u ? B_EXACT : B_CLASS;
+    if(want == got) return B_EXACT;
+    int64_t d = ordered(want) - ordered(got);
+    ulps = (uint64_t)(d < 0 ? -d : d);
+    if(!ulps) return B_CLASS;                        // signed-zero mismatch
+    return ulps == 1 ? B_1 : ulps == 2 ? B_2 : ulps <= 4 ? B_4 : ulps <= 16 ? B_16 : ulps <= 256 ? B_256 : B_FAR;
+}
+
+// ============================== Operand generation ==============================
+static const uint32_t kSpecials[] = {
+    0x00000000u,                                     // zero
+    0x00000001u, 0x00000002u, 0x00400001u, 0x007FFFFFu,   // subnormals: min, 2*min, middle, max
+    0x00800000u, 0x00800001u, 0x01000000u,           // smallest normals
+    0x33800000u, 0x34000000u,                        // 2^-24, 2^-23 (half ulp / ulp of 1.0)
+    0x3F800000u, 0x3F800001u, 0x3FC00000u, 0x3FFFFFFFu,   // 1.0, 1 + ulp, 1.5, 2 - ulp
+    0x4B800000u,                                     // 2^24
+    0x7F000000u, 0x7F7FFFFEu, 0x7F7FFFFFu,           // largest normals
+    0x7F800000u,                                     // Inf
+    0x7FC00000u, 0x7FC12345u,                        // quiet NaNs
+    0x7F800001u, 0x7FA00000u,                        // signaling NaNs
+};
+constexpr int kSpecialCount = sizeof kSpecials / sizeof kSpecials[0];
+constexpr uint64_t kSpecialPairs = 4ull * kSpecialCount * kSpecialCount;   // both signs on both sides
+
+static uint64_t splitmix64(uint64_t x){
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static uint32_t withExp(uint32_t u, int e){ return (u & 0x807FFFFFu) | ((uint32_t)e << 23); }
+static int clampExp(int e){ return e < 0 ? 0 : e > 254 ? 254 : e; }
+
+static void specialPair(uint64_t index, uint32_t& a, uint32_t& b){
+    uint64_t i = index / 4, s = index % 4;
+    a = kSpecials[i / kSpecialCount] | (s & 1 ? 0x80000000u : 0);
+    b = kSpecials[i % kSpecialCount] | (s & 2 ? 0x80000000u : 0);
+}
+
+static void randomPair(FOp op, int mode, uint64_t index, uint64_t seed, uint32_t& a, uint32_t& b){
+    uint64_t r = splitmix64(seed ^ splitmix64((index * F_OPS + op) * 5 + mode));
+    uint64_t p = splitmix64(r);
+    a = (uint32_t)r; b = (uint32_t)(r >> 32);
+    int ea = (a >> 23) & 0xFF, kind = (int)(p % 6);
+    int delta = (int)((p >> 8) % 7) - 3;
+    switch(kind){
+    case 0: break;                                                              // uniform patterns
+    case 1: b = withExp(b, clampExp(ea == 255 ? 127 + delta : ea + delta)); break;   // close exponents
+    case 2: a = withExp(a, (int)((p >> 16) % 3)); b = withExp(b, (int)((p >> 20) % 3)); break;   // subnormal range
+    case 3: {                                                                   // exponent sum near an edge
+        int target = (p >> 16) & 1 ? 254 + 127 : 127;
+        a = withExp(a, clampExp(ea == 255 ? 200 : ea));
+        b = withExp(b, clampExp(target - ((a >> 23) & 0xFF) + delta));
+        break; }
+    case 4: {                                                                   // b at the rounding position of a
+        int e = ea == 255 ? 150 : ea;
+        b = withExp(b, clampExp(e - 23 - (int)((p >> 16) % 4)));
+        if((p >> 20) & 1) b &= 0xFFFF0000u;                                     // few bits set: exact ties
+        break; }
+    default: {                                                                  // one special operand
+        uint32_t s = kSpecials[(p >> 16) % kSpecialCount] | (uint32_t)((p >> 24) & 1) << 31;
+        if((p >> 25) & 1) a = s; else b = s;
+        break; }
+    }
+}
+
+// ============================== Driver ==============================
+struct Options {
+    bool ops[F_OPS] = { true, true, true, true, true };
+    bool modes[5] = { true, true, true, true, true };
+    uint64_t randomPairs = 1000000, seed = 1;
+    unsigned threads = 0;
+    int show = 10;
+};
+
+struct Job { FOp op; int mode; bool specials; uint64_t count; };
+struct Mismatch { size_t job; uint64_t index; uint32_t a, b, want, got; uint64_t ulps; };
+
+constexpr uint64_t kChunk = 1u << 14;   // pairs per work chunk
+
+struct Run {
+    const Options& opt;
+    vector<Job> jobs;
+    vector<uint64_t> chunkStart;
+    uint64_t totalChunks = 0;
+
+    atomic<uint64_t> nextChunk{0};
+    mutex lock;                          // guards hist, bad
+    vector<array<uint64_t, B_COUNT>> hist;
+    vector<Mismatch> bad;                // the first opt.show by (job, index)
+
+    explicit Run(const Options& o) : opt(o) {}
+
+    void plan(){
+        for(int op=0; op<F_OPS; ++op) for(int m=0; m<5; ++m){
+            if(!opt.ops[op] || !opt.modes[m]) continue;
+            jobs.push_back({ (FOp)op, m, true, kSpecialPairs });
+            if(opt.randomPairs) jobs.push_back({ (FOp)op, m, false, opt.randomPairs });
+        }
+        for(const Job& j : jobs){ chunkStart.push_back(totalChunks); totalChunks += (j.count + kChunk - 1) / kChunk; }
+        hist.assign(jobs.size(), array<uint64_t, B_COUNT>{});
+    }
+
+    void worker(){
+        vector<array<uint64_t, B_COUNT>> local(jobs.size(), array<uint64_t, B_COUNT>{});
+        vector<Mismatch> found;
+        for(;;){
+            uint64_t chunk = nextChunk.fetch_add(1);
+            if(chunk >= totalChunks) break;
+            size_t job = upper_bound(chunkStart.begin(), chunkStart.end(), chunk) - chunkStart.begin() - 1;
+            const Job& j = jobs[job];
+            uint64_t first = (chunk - chunkStart[job]) * kChunk;
+            uint64_t count = min(kChunk, j.count - first);
+            fesetround(kHostMode[j.mode]);
+            for(uint64_t i = first; i < first + count; ++i){
+                uint32_t a, b;
+                if(j.specials) specialPair(i, a, b); else randomPair(j.op, j.mode, i, opt.seed, a, b);
+                uint32_t want = reference(j.op, j.mode, a, b), got = unit(j.op, j.mode, a, b);
+                uint64_t ulps;
+                Bucket k = classify(want, got, ulps);
+                local[job][k]++;
+                if(k != B_EXACT && found.size() < (size_t)opt.show) found.push_back({ job, i, a, b, want, got, ulps });
+            }
+        }
+        fesetround(FE_TONEAREST);
+        lock_guard<mutex> g(lock);
+        for(size_t j=0;j<jobs.size();++j) for(int k=0;k<B_COUNT;++k) hist[j][k] += local[j][k];
+        bad.insert(bad.end(), found.begin(), found.end());
+    }
+};
+
+static bool parseU64(const char* s, uint64_t& v){ char* e; v = strtoull(s, &e, 0); return *s && !*e; }
+
+static int usage(){
+    fprintf(stderr, "usage: float_verify [--ops add,sub,mul,div,sqrt] [--modes rne,rtz,rdn,rup,rmm] [--random N] [--seed S]\n"
+                    "                    [--threads T] [--show K]\n");
+    return 2;
+}
+
+int main(int argc, char** argv){
+    Options opt;
+    for(int i=1;i<argc;++i){
+        string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        uint64_t x = 0;
+        if(arg == "--random" && (v = next()) && parseU64(v, x)) opt.randomPairs = x;
+        else if(arg == "--seed" && (v = next()) && parseU64(v, x)) opt.seed = x;
+        else if(arg == "--threads" && (v = next()) && parseU64(v, x)) opt.threads = (unsigned)x;
+        else if(arg == "--show" && (v = next()) && parseU64(v, x)) opt.show = (int)x;
+        else if(arg == "--ops" && (v = next())){
+            string s = v;
+            for(int k=0;k<F_OPS;++k) opt.ops[k] = s.find(kOpName[k]) != string::npos;
+        }
+        else if(arg == "--modes" && (v = next())){
+            string s = v;
+            for(int k=0;k<5;++k) opt.modes[k] = s.find(kModeName[k]) != string::npos;
+        }
+        else return usage();
+    }
+    if(!opt.threads) opt.threads = max(1u, thread::hardware_concurrency());
+
+    Run run(opt);
+    run.plan();
+    uint64_t total = 0;
+    for(const Job& j : run.jobs) total += j.count;
+    printf("float_verify: %zu jobs, %llu pairs, %u threads, adder %s, MUL engine %s, DIV engine %s, div/sqrt %s, seed %llu\n",
+           run.jobs.size(), (unsigned long long)total, opt.threads, FLOAT_ADDER::name(), MUL_ENGINE::name(),
+           DIV_ENGINE::name(), FLOAT_DIV_ENGINE::name(), (unsigned long long)opt.seed);
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for(unsigned t=0;t<opt.threads;++t) pool.emplace_back([&run]{ run.worker(); });
+    for(thread& t : pool) t.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    printf("\n%-4s %-4s %-8s %12s", "op", "mode", "job", "pairs");
+    for(int k=0;k<B_COUNT;++k) printf(" %9s", kBucketName[k]);
+    printf("\n");
+    uint64_t mismatches = 0;
+    for(size_t j=0;j<run.jobs.size();++j){
+        const Job& job = run.jobs[j];
+        printf("%-4s %-4s %-8s %12llu", kOpName[job.op], kModeName[job.mode], job.specials ? "specials" : "random",
+               (unsigned long long)job.count);
+        for(int k=0;k<B_COUNT;++k) printf(" %9llu", (unsigned long long)run.hist[j][k]);
+        printf("\n");
+        mismatches += job.count - run.hist[j][B_EXACT];
+    }
+
+    sort(run.bad.begin(), run.bad.end(), [](const Mismatch& x, const Mismatch& y){ return x.job != y.job ? x.job < y.job : x.index < y.index; });
+    if(run.bad.size() > (size_t)opt.show) run.bad.resize(opt.show);
+    for(const Mismatch& m : run.bad){
+        const Job& job = run.jobs[m.job];
+        printf("MISMATCH %s %s %s #%llu: a=0x%08X (%g) b=0x%08X (%g) want=0x%08X (%g) got=0x%08X (%g) ulps=%llu\n",
+               kOpName[job.op], kModeName[job.mode], job.specials ? "specials" : "random", (unsigned long long)m.index,
+               m.a, asFloat(m.a), m.b, asFloat(m.b), m.want, asFloat(m.want), m.got, asFloat(m.got), (unsigned long long)m.ulps);
+    }
+    printf("\n%llu of %llu pairs bit-exact in %.1f s (%.2f Mpairs/s)\n", (unsigned long long)(total - mismatches),
+           (unsigned long long)total, secs, total / secs / 1e6);
+    return mismatches ? 1 : 0;
+}
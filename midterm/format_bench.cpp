@@ -0,0 +1,270 @@
+// format_bench.cpp - the format-templated float engine: cross-checks, then speed per format
+// Build: g++ -O2 -std=c++17 -frounding-math format_bench.cpp -o format_bench
+//        (add -mavx2 for the 256-bit batch kernels; FLOAT_ADDER / MUL_ENGINE pick the units)
+// Usage: format_bench [operations]
+// Checks, per rounding mode: binary32 add/sub/mul against the Float32 units bit for bit;
+// binary16, bfloat16 and binary32 add/sub/mul against a host reference (the double result
+// rounded to odd, then rounded to the format); binary64 against host double (RMM skipped:
+// no host mode); every conversion between the four formats against the same reference, and
+// the batch kernel against the scalar conversion. Any host NaN matches the canonical NaN.
+// Exit code: 0 all passed, 1 mismatch.
+#include "float_formats.h"
+
+#include <cfenv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+static double nowNs(){ return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+static const char* kModeName[5] = { "rne", "rtz", "rdn", "rup", "rmm" };
+static const int kHostMode[5] = { FE_TONEAREST, FE_TOWARDZERO, FE_DOWNWARD, FE_UPWARD, FE_TONEAREST };
+
+static long failures = 0;
+static void check(bool ok, const char* what, const char* fmt, int mode, uint64_t a, uint64_t b, uint64_t got, uint64_t want){
+    if(!ok && failures++ < 10)
+        printf("MISMATCH %s %s %s: %llx, %llx -> %llx, want %llx\n", what, fmt, kModeName[mode],
+               (unsigned long long)a, (unsigned long long)b, (unsigned long long)got, (unsigned long long)want);
+}
+
+// ============================== Host reference (TEST side: host arithmetic fine) ==============================
+template <class Fmt> static uint64_t word(const FloatWord<Fmt>& x){ return x.w[0]; }
+template <class Fmt> static FloatWord<Fmt> fromWord(uint64_t u){ FloatWord<Fmt> x; x.w[0] = u; trimTop(x); return x; }
+
+template <class Fmt>
+static double toDouble(uint64_t u){
+    const int E = Fmt::kExp, F = Fmt::kFrac;
+    int sign = (int)(u >> (E + F)) & 1, e = (int)(u >> F) & ((1 << E) - 1);
+    uint64_t f = u & ((1ull << F) - 1);
+    double v = e == (1 << E) - 1 ? (f ? NAN : INFINITY)
+             : e == 0 ? ldexp((double)f, 1 - Fmt::kBias - F) : ldexp((double)(f | 1ull << F), e - Fmt::kBias - F);
+    return sign ? -v : v;
+}
+
+template <class Fmt> static uint64_t canonicalNaNWord(){ FloatWord<Fmt> x; canonicalNaN<Fmt>(x); return word<Fmt>(x); }
+
+// x rounded to Fmt under mode (x itself exact, or rounded to odd with 2+ spare bits)
+template <class Fmt>
+static uint64_t refRound(double x, int mode){
+    const int E = Fmt::kExp, F = Fmt::kFrac, bias = Fmt::kBias;
+    if(std::isnan(x)) return canonicalNaNWord<Fmt>();
+    uint64_t sign = std::signbit(x) ? 1ull << (E + F) : 0, infBits = (uint64_t)((1 << E) - 1) << F;
+    double ax = fabs(x);
+    if(std::isinf(ax)) return sign | infBits;
+    if(ax == 0) return sign;
+    int e; frexp(ax, &e); --e;                           // ax in [2^e, 2^(e+1))
+    int q = (e > 1 - bias ? e : 1 - bias) - F;           // weight of the last kept bit
+    double scaled = ldexp(ax, -q);
+    uint64_t n = (uint64_t)scaled;
+    double rest = scaled - (double)n;
+    int neg = sign != 0, inc = 0;
+    switch(mode){
+        case 0: inc = rest > 0.5 || (rest == 0.5 && (n & 1)); break;
+        case 2: inc = neg && rest > 0; break;
+        case 3: inc = !neg && rest > 0; break;
+        case 4: inc = rest >= 0.5; break;
+    }
+    n += inc;
+    uint64_t bits = e < 1 - bias ? n : ((uint64_t)(e + bias - 1) << F) + n;   // the hidden bit carries into the field
+    if(bits >= infBits){
+        bool toInf = mode == 0 || mode == 4 || (mode == 3 && !neg) || (mode == 2 && neg);
+        return sign | (toInf ? infBits : infBits - 1);
+    }
+    return sign | bits;
+}
+
+// x op y in double rounded to odd: exact enough for any format of 50 or fewer significand bits
+static double opOdd(double x, double y, int op){
+    fesetround(FE_TOWARDZERO);
+    feclearexcept(FE_INEXACT);
+    volatile double vx = x, vy = y;
+    volatile double r = op == 0 ? vx + vy : op == 1 ? vx - vy : vx * vy;
+    int inexact = fetestexcept(FE_INEXACT);
+    fesetround(FE_TONEAREST);
+    double s = r;
+    if(inexact){ uint64_t u; memcpy(&u, &s, 8); u |= 1; memcpy(&s, &u, 8); }
+    return s;
+}
+
+// sign of an exact zero sum: -0 + -0 stays -0, any other cancellation is +0 (-0 rounding down)
+static double zeroSum(double x, double y, int op, int mode){
+    double yy = op == 1 ? -y : y;
+    if(x == 0 && yy == 0 && std::signbit(x) == std::signbit(yy)) return x;
+    return mode == 2 ? -0.0 : 0.0;
+}
+
+// ============================== Operands ==============================
+template <class Fmt>
+static uint64_t special(uint64_t k){
+    const int E = Fmt::kExp, F = Fmt::kFrac;
+    uint64_t expOnes = (uint64_t)((1 << E) - 1) << F, one = (uint64_t)Fmt::kBias << F;
+    const uint64_t v[] = { 0, 1, (1ull << F) - 1, 1ull << F, one, expOnes - 1, expOnes, expOnes | 1, expOnes | 1ull << (F - 1), one | 1 };
+    return v[k % 10] | (k & 16 ? 1ull << (E + F) : 0);
+}
+
+template <class Fmt>
+static uint64_t operand(size_t i){
+    const int E = Fmt::kExp, F = Fmt::kFrac, W = Fmt::kWidth;
+    uint64_t mask = W == 64 ? ~0ull : (1ull << W) - 1, r = rnd64() & mask;
+    switch(i % 8){
+        case 5: return special<Fmt>(rnd64());
+        case 6: return r & ~((uint64_t)((1 << E) - 2) << F);          // subnormal or exponent 1
+        case 7: return (r & ~((uint64_t)((1 << E) - 1) << F)) | ((uint64_t)(Fmt::kBias - 4 + (int)(rnd64() % 9)) << F);
+        default: return r;
+    }
+}
+
+// b close to a (cancellation, carries) every fourth pair
+template <class Fmt>
+static uint64_t partner(uint64_t a, size_t i){
+    if(i % 4) return operand<Fmt>(i + 3);
+    uint64_t flip = rnd64() & ((1ull << (Fmt::kFrac / 2 + 1)) - 1);
+    return (a ^ flip) ^ (rnd64() & 1 ? 1ull << (Fmt::kWidth - 1) : 0);
+}
+
+// ============================== Checks ==============================
+// binary32 against the Float32 units
+static void checkBinary32Units(size_t n){
+    for(size_t i=0;i<n;++i){
+        uint64_t a = operand<Binary32>(i), b = partner<Binary32>(a, i);
+        Bits<32> A = fromWord<Binary32>(a), B = fromWord<Binary32>(b), r, w;
+        for(int m=0;m<5;++m){
+            RoundingMode rm = (RoundingMode)m;
+            floatAddSub(A,B,false,r,rm); floatAddSubF<Binary32>(A,B,false,w,rm);
+            check(sameBits(r,w), "add vs Float32", "binary32", m, a, b, w.w[0], r.w[0]);
+            floatAddSub(A,B,true,r,rm); floatAddSubF<Binary32>(A,B,true,w,rm);
+            check(sameBits(r,w), "sub vs Float32", "binary32", m, a, b, w.w[0], r.w[0]);
+            floatMultiply(A,B,r,rm); floatMultiplyF<Binary32>(A,B,w,rm);
+            check(sameBits(r,w), "mul vs Float32", "binary32", m, a, b, w.w[0], r.w[0]);
+        }
+    }
+}
+
+// formats of up to 24 significand bits against the rounded-to-odd double result
+template <class Fmt>
+static void checkArith(size_t n){
+    for(size_t i=0;i<n;++i){
+        uint64_t a = operand<Fmt>(i), b = partner<Fmt>(a, i);
+        FloatWord<Fmt> A = fromWord<Fmt>(a), B = fromWord<Fmt>(b), r;
+        double x = toDouble<Fmt>(a), y = toDouble<Fmt>(b);
+        for(int m=0;m<5;++m){
+            RoundingMode rm = (RoundingMode)m;
+            for(int op=0;op<3;++op){
+                double d = opOdd(x, y, op);
+                if(d == 0 && op < 2) d = zeroSum(x, y, op, m);
+                uint64_t want = refRound<Fmt>(d, m);
+                if(op < 2) floatAddSubF<Fmt>(A, B, op == 1, r, rm); else floatMultiplyF<Fmt>(A, B, r, rm);
+                check(word<Fmt>(r) == want, op == 0 ? "add" : op == 1 ? "sub" : "mul", Fmt::name(), m, a, b, word<Fmt>(r), want);
+            }
+        }
+    }
+}
+
+// binary64 against host double under the host rounding mode
+static void checkBinary64(size_t n){
+    const uint64_t nan = canonicalNaNWord<Binary64>();
+    for(size_t i=0;i<n;++i){
+        uint64_t a = operand<Binary64>(i), b = partner<Binary64>(a, i);
+        Bits<64> A = fromWord<Binary64>(a), B = fromWord<Binary64>(b), r;
+        double x, y; memcpy(&x, &a, 8); memcpy(&y, &b, 8);
+        for(int m=0;m<4;++m){
+            fesetround(kHostMode[m]);
+            volatile double vx = x, vy = y;
+            double h[3] = { vx + vy, vx - vy, vx * vy };
+            fesetround(FE_TONEAREST);
+            for(int op=0;op<3;++op){
+                uint64_t want; memcpy(&want, &h[op], 8);
+                if(std::isnan(h[op])) want = nan;
+                if(op < 2) floatAddSubF<Binary64>(A, B, op == 1, r, (RoundingMode)m); else floatMultiplyF<Binary64>(A, B, r, (RoundingMode)m);
+                check(r.w[0] == want, op == 0 ? "add" : op == 1 ? "sub" : "mul", "binary64", m, a, b, r.w[0], want);
+            }
+        }
+    }
+}
+
+// From -> To: scalar against the reference, the batch kernel against the scalar
+template <class From, class To>
+static void checkConvert(size_t n){
+    vector<FloatWord<From>> in(n);
+    vector<FloatWord<To>> batch(n), scalar(n);
+    for(size_t i=0;i<n;++i) in[i] = fromWord<From>(operand<From>(i));
+    char what[64]; snprintf(what, sizeof what, "%s->%s", From::name(), To::name());
+    for(int m=0;m<5;++m){
+        RoundingMode rm = (RoundingMode)m;
+        convertFloatBatch<From,To>(in.data(), batch.data(), n, rm);
+        for(size_t i=0;i<n;++i){
+            convertFloat<From,To>(in[i], scalar[i], rm);
+            uint64_t a = word<From>(in[i]), want = refRound<To>(toDouble<From>(a), m);
+            check(word<To>(scalar[i]) == want, what, "scalar", m, a, 0, word<To>(scalar[i]), want);
+            check(sameBits(batch[i], scalar[i]), what, "batch", m, a, 0, word<To>(batch[i]), word<To>(scalar[i]));
+        }
+    }
+}
+
+template <class From>
+static void checkConvertFrom(size_t n){
+    checkConvert<From,Binary16>(n); checkConvert<From,BFloat16>(n);
+    checkConvert<From,Binary32>(n); checkConvert<From,Binary64>(n);
+}
+
+// ============================== Speed ==============================
+template <class F>
+static double timeNs(size_t n, F f){
+    double t0 = nowNs();
+    f();
+    return (nowNs() - t0) / (double)n;
+}
+
+template <class Fmt>
+static void arithRow(size_t n){
+    vector<FloatWord<Fmt>> a(n), b(n);
+    for(size_t i=0;i<n;++i){ a[i] = fromWord<Fmt>(operand<Fmt>(i)); b[i] = fromWord<Fmt>(partner<Fmt>(a[i].w[0], i)); }
+    FloatWord<Fmt> r, sink;
+    double add = timeNs(n, [&]{ for(size_t i=0;i<n;++i){ floatAddSubF<Fmt>(a[i],b[i],false,r); sink.w[0] ^= r.w[0]; } });
+    double mul = timeNs(n, [&]{ for(size_t i=0;i<n;++i){ floatMultiplyF<Fmt>(a[i],b[i],r); sink.w[0] ^= r.w[0]; } });
+    printf("%-9s %10.1f %10.1f%s\n", Fmt::name(), add, mul, sink.w[0] == 1 ? " " : "");
+}
+
+template <class From, class To>
+static void convertRow(size_t n){
+    vector<FloatWord<From>> in(n);
+    vector<FloatWord<To>> out(n);
+    for(size_t i=0;i<n;++i) in[i] = fromWord<From>(operand<From>(i));
+    double s = timeNs(n, [&]{ for(size_t i=0;i<n;++i) convertFloat<From,To>(in[i], out[i]); });
+    double v = timeNs(n, [&]{ convertFloatBatch<From,To>(in.data(), out.data(), n); });
+    printf("%-9s -> %-9s %10.1f %10.1f %8.1fx %9.1f\n", From::name(), To::name(), s, v, s / v, 1e3 / v);
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 20000;
+    if(n < 8) n = 8;
+
+    printf("float formats: FLOAT adder %s, MUL %s, batch planes %s\n\n", FLOAT_ADDER::name(), MUL_ENGINE::name(),
+#if defined(__AVX2__)
+           "AVX2"
+#else
+           "4 x 64-bit"
+#endif
+    );
+    double t0 = nowNs();
+    checkBinary32Units(n);
+    checkArith<Binary16>(n); checkArith<BFloat16>(n); checkArith<Binary32>(n);
+    checkBinary64(n / 4);
+    checkConvertFrom<Binary16>(n); checkConvertFrom<BFloat16>(n); checkConvertFrom<Binary32>(n); checkConvertFrom<Binary64>(n);
+    printf("cross-checks: %s (%.1f s)\n\n", failures ? "MISMATCH" : "ok", (nowNs() - t0) / 1e9);
+
+    printf("ns per operation (RNE)\n%-9s %10s %10s\n", "format", "add", "mul");
+    arithRow<Binary16>(n); arithRow<BFloat16>(n); arithRow<Binary32>(n); arithRow<Binary64>(n / 4);
+    printf("\nconversions, ns per value (RNE)\n%-22s %10s %10s %9s %9s\n", "", "scalar", "batch", "speedup", "M/s batch");
+    convertRow<Binary32,Binary16>(n); convertRow<Binary16,Binary32>(n);
+    convertRow<Binary32,BFloat16>(n); convertRow<BFloat16,Binary32>(n);
+    convertRow<Binary64,Binary32>(n); convertRow<Binary32,Binary64>(n);
+    convertRow<Binary64,Binary16>(n); convertRow<BFloat16,Binary16>(n);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+// mul_bench.cpp - shape and speed of every MUL engine, checked against host 64-bit products
+// Build: g++ -O2 -std=c++17 mul_bench.cpp -o mul_bench      (-DMUL_ADDER=... changes the shift-add adder)
+// Usage: mul_bench [operations]
+#include "numeric_ops.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static unsigned rngState = 2463534242u;
+static int rnd(){ rngState^=rngState<<13; rngState^=rngState>>17; rngState^=rngState<<5; return (int)rngState; }
+
+struct Case { Bits<32> a, b; long long ss; unsigned long long uu; long long su; };
+
+// host reference, Section 2 style (host ints are fine outside the units)
+static void expect(const Case& c, int kind, uint32_t& hi, uint32_t& lo){
+    uint64_t p = kind==0 ? (uint64_t)c.ss : kind==1 ? c.uu : (uint64_t)c.su;
+    hi = (uint32_t)(p >> 32); lo = (uint32_t)p;
+}
+
+template <class Engine>
+static void row(const vector<Case>& cases){
+    size_t n = cases.size();
+    vector<Bits<64>> prod(n);
+    int bad = 0;
+    double ns[3];
+    for(int kind=0; kind<3; ++kind){
+        int sa = kind!=1, sb = kind==0;                  // ss, uu, su
+        auto t0 = chrono::steady_clock::now();
+        for(size_t i=0;i<n;++i) Engine::multiply(cases[i].a, sa, cases[i].b, sb, prod[i], false);
+        ns[kind] = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / (double)n;
+        for(size_t i=0;i<n;++i){
+            uint32_t hi, lo; expect(cases[i], kind, hi, lo);
+            Bits<32> h, l; splitHiLo(prod[i], h, l);
+            if((uint32_t)bitsToInt(h)!=hi || (uint32_t)bitsToInt(l)!=lo) bad++;
+        }
+    }
+    MulShape s = Engine::shape();
+    double avg = (ns[0]+ns[1]+ns[2]) / 3;
+    printf("%-20s %4d %4d %6d %5d %5d %6d %5d %9.1f %9.1f %9.1f %9.2f  %s\n", Engine::name(),
+           s.partialProducts, s.preAdds, s.treeLevels, s.fullAdders, s.halfAdders, s.finalAdd.gates, s.finalAdd.depth,
+           ns[0], ns[1], ns[2], 1000.0/avg, bad ? "MISMATCH" : "ok");
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    vector<Case> cases(n);
+    for(size_t i=0;i<n;++i){
+        int x=rnd(), y=rnd();
+        if(i%11==0) y=0;
+        if(i%13==0){ x=(int)0x80000000; y=(i%2)?-1:(int)0x80000000; }
+        if(i%17==0) x=-1;
+        cases[i].a=intToBits(x); cases[i].b=intToBits(y);
+        cases[i].ss=(long long)x*(long long)y;
+        cases[i].uu=(unsigned long long)(unsigned)x*(unsigned long long)(unsigned)y;
+        cases[i].su=(long long)x*(long long)(unsigned)y;
+    }
+    printf("%zu operations per kind; FA/HA = 3:2 counters with 3/2 live inputs (64-wire rows, sign extension included);\n"
+           "add g/d = final adder gates/depth; \"Dadda rows\" = Dadda heights on whole rows, not per column\n\n", n);
+    printf("%-20s %4s %4s %6s %5s %5s %6s %5s %9s %9s %9s %9s  %s\n", "engine", "PPs", "pre", "levels", "FA", "HA",
+           "add g", "add d", "ss ns/op", "uu ns/op", "su ns/op", "Mop/s", "check");
+    row<ShiftAddMul>(cases);
+    row<Booth4Wallace>(cases);
+    row<Booth4Dadda>(cases);
+    row<Booth8Wallace>(cases);
+    row<Booth8Dadda>(cases);
+    return 0;
+}
@@ -0,0 +1,198 @@
+// multipliers.h - Booth-encoded multiplier engines with carry-save reduction trees
+// Operands are recoded radix-4 or radix-8 (signed, unsigned and mixed-sign handled
+// directly by how each operand is extended), the partial products are reduced to two
+// rows by a tree of whole-row 3:2 counters on a Wallace or Dadda-height row schedule, and
+// one final add gives the product.
+// The shift-add engine and the MUL_ENGINE selection live in numeric_ops.h.
+#pragma once
+
+#include "adders.h"
+
+#include <cstdint>
+
+// ============================= Section 1b: Multipliers (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---------------- Shape report ----------------
+// Structure only (host ints are fine here): what the engine would cost as hardware.
+struct MulShape {
+    int partialProducts;   // Booth rows (plus one row of negation bits) / shift-add steps
+    int preAdds;           // carry-propagate adds before the tree (radix-8 hard multiple 3A)
+    int treeLevels;        // 3:2 counter levels from partial products to two rows
+    int fullAdders;        // counters with three live inputs
+    int halfAdders;        // counters with two live inputs
+    AdderCost finalAdd;    // the carry-propagate adder that finishes the product
+};
+
+// operand extension: M wires, sign- or zero-extended from N
+template <int M, int N>
+inline void extendOperand(const Bits<N>& x, int isSigned, Bits<M>& y) {
+    resizeBits(x, y);
+    if (isSigned && x.get(N - 1)) {
+        Bits<M> hi; for (int j = 0; j < Bits<M>::W; ++j) hi.w[j] = ~(uint64_t)0;
+        trimTop(hi); wireShiftUp(hi, N, hi);
+        for (int j = 0; j < Bits<M>::W; ++j) y.w[j] |= hi.w[j];
+    }
+}
+
+// ---------------- Carry-save reduction trees ----------------
+// Rows are 64-bit; every row is one word, so a 3:2 counter on a whole row is one
+// word-wide fullAdder (64 counters side by side) plus the carry routed up one wire.
+// The tree is data-independent: it is scheduled once per (rows, kind) as a list of
+// counters over numbered row slots, and the same schedule counts the hardware.
+constexpr int kMaxMulRows = 24;
+constexpr int kMaxMulSlots = 3 * kMaxMulRows;
+
+struct CsaOp { int a, b, c, sum, carry; };
+
+struct TreeSchedule {
+    int ops = 0, levels = 0, fullAdders = 0, halfAdders = 0;
+    int outA = 0, outB = 1;
+    CsaOp op[kMaxMulRows];
+};
+
+// Wallace: every level compresses as many groups of three as it can.
+struct WallaceTree {
+    static constexpr int kDadda = 0;
+    static int counters(int rows) { return rows / 3; }
+};
+
+// Dadda row schedule: every level only compresses down to the next height in 2,3,4,6,9,
+// 13,19,28,... The heights apply to whole rows, not per column as in Dadda's reduction, so
+// this is the Wallace tree with fewer counters per level: FA/HA counts stay close to
+// Wallace's (and both include the sign-extension wires of the 64-wire rows).
+struct DaddaTree {
+    static constexpr int kDadda = 1;
+    static int counters(int rows) {
+        int d = 2;
+        while (d + d / 2 < rows) d = d + d / 2;
+        return rows - d;
+    }
+};
+
+inline int popcount64(uint64_t x) { return __builtin_popcountll(x); }
+
+// occ[r] = columns where row r can be nonzero; used to count full vs half adders
+template <class Tree>
+inline TreeSchedule scheduleTree(int rows, const uint64_t* occIn) {
+    TreeSchedule t;
+    uint64_t occ[kMaxMulSlots];
+    int live[kMaxMulRows], n = rows, slots = rows;
+    for (int r = 0; r < rows; ++r) { live[r] = r; occ[r] = occIn[r]; }
+    while (n > 2) {
+        int k = Tree::counters(n), next[kMaxMulRows], m = 0;
+        for (int g = 0; g < k; ++g) {
+            CsaOp o{ live[3 * g], live[3 * g + 1], live[3 * g + 2], slots, slots + 1 };
+            slots += 2;
+            uint64_t a = occ[o.a], b = occ[o.b], c = occ[o.c];
+            uint64_t three = a & b & c, two = ((a & b) | (a & c) | (b & c)) & ~three;
+            t.fullAdders += popcount64(three);
+            t.halfAdders += popcount64(two);
+            occ[o.sum] = a | b | c;
+            occ[o.carry] = (three | two) << 1;   // structure mask, not a modeled value
+            t.op[t.ops++] = o;
+            next[m++] = o.sum; next[m++] = o.carry;
+        }
+        for (int r = 3 * k; r < n; ++r) next[m++] = live[r];
+        for (int r = 0; r < m; ++r) live[r] = next[r];
+        n = m;
+        t.levels++;
+    }
+    t.outA = live[0]; t.outB = n > 1 ? live[1] : live[0];
+    return t;
+}
+
+template <int N>
+inline void runTree(const TreeSchedule& t, Bits<N>* slot) {
+    for (int i = 0; i < t.ops; ++i) {
+        const CsaOp& o = t.op[i];
+        Bits<N> k;
+        for (int j = 0; j < Bits<N>::W; ++j)
+            fullAdder(slot[o.a].w[j], slot[o.b].w[j], slot[o.c].w[j], slot[o.sum].w[j], k.w[j]);
+        wireShiftUp(k, 1, slot[o.carry]);
+    }
+}
+
+// ---------------- Booth recoding ----------------
+// Radix 2^k: multiplier digit i looks at wires (k*i+k-1 .. k*i-1) and picks
+// 0, +-A, +-2A (, +-3A, +-4A). A negative digit is the inverted multiple plus a 1 at the
+// digit's position; all those 1s share one extra row. Rows are sign-extended to 64 wires.
+struct BoothDigit { int neg, one, two, three, four; };
+
+// x = the digit's wires, top first (x3 only used by radix 8)
+inline BoothDigit booth4Digit(int x2, int x1, int x0) {
+    int y1 = x1 ^ x2, y0 = x0 ^ x2;                // magnitude = y1 + y0
+    return { x2 & ((x1 & x0) ^ 1), y1 ^ y0, y1 & y0, 0, 0 };
+}
+inline BoothDigit booth8Digit(int x3, int x2, int x1, int x0) {
+    int y2 = x2 ^ x3, y1 = x1 ^ x3, y0 = x0 ^ x3; // magnitude = 2*y2 + y1 + y0
+    return { x3 & ((x2 & x1 & x0) ^ 1),
+             (y2 ^ 1) & (y1 ^ y0),
+             ((y2 ^ 1) & y1 & y0) | (y2 & (y1 ^ 1) & (y0 ^ 1)),
+             y2 & (y1 ^ y0),
+             y2 & y1 & y0 };
+}
+
+// Booth multiplier engine. Radix is 4 or 8; Tree is WallaceTree or DaddaTree (row schedule); FinalAdder
+// also builds the radix-8 hard multiple. numeric_ops.h names the combinations.
+// Both operands are 32-bit and extended to 33 bits (signed or unsigned), then padded to
+// a whole number of digits. Only the low 64 product wires are kept; that is exact here.
+template <int Radix, class Tree, class FinalAdder>
+struct BoothMul {
+    static_assert(Radix == 4 || Radix == 8, "Booth radix 4 or 8");
+    static constexpr int kDigitBits = Radix == 4 ? 2 : 3;
+    static constexpr int kDigits = (33 + kDigitBits - 1) / kDigitBits;   // 17 or 11
+    static constexpr int kRows = kDigits + 1;                               // + negation-bit row
+
+    static const char* name() {
+        static const char* const names[2][2] = { { "Booth-4 + Wallace", "Booth-4 + Dadda rows" },
+                                                 { "Booth-8 + Wallace", "Booth-8 + Dadda rows" } };
+        return names[Radix == 8][Tree::kDadda];
+    }
+
+    static const TreeSchedule& schedule() {
+        static const TreeSchedule s = []{
+            uint64_t occ[kRows];
+            uint64_t neg = 0;
+            for (int d = 0; d < kDigits; ++d) {
+                occ[d] = ~(uint64_t)0 << (kDigitBits * d);   // structure mask: row d starts at its digit
+                neg |= (uint64_t)1 << (kDigitBits * d);
+            }
+            occ[kDigits] = neg;
+            return scheduleTree<Tree>(kRows, occ);
+        }();
+        return s;
+    }
+
+    static MulShape shape() {
+        const TreeSchedule& t = schedule();
+        return { kRows, Radix == 8 ? 1 : 0, t.levels, t.fullAdders, t.halfAdders, FinalAdder::template cost<64>() };
+    }
+
+    static void multiply(const Bits<32>& a, int aSigned, const Bits<32>& b, int bSigned, Bits<64>& prod, bool /*trace*/) {
+        Bits<64> m1, m2, m3, m4;
+        extendOperand(a, aSigned, m1);
+        wireShiftUp(m1, 1, m2);
+        if (Radix == 8) { int c = 0; FinalAdder::add(m1, m2, m3, c); wireShiftUp(m1, 2, m4); }
+
+        Bits<kDigits * kDigitBits> x; extendOperand(b, bSigned, x);   // multiplier, padded
+
+        Bits<64> slot[kMaxMulSlots];
+        Bits<64>& negRow = slot[kDigits];
+        int pos = 0;                                                   // digit position (wiring only)
+        for (int d = 0; d < kDigits; ++d, pos += kDigitBits) {
+            int xm1 = pos ? x.get(pos - 1) : 0;
+            BoothDigit g = Radix == 4
+                ? booth4Digit(x.get(pos + 1), x.get(pos), xm1)
+                : booth8Digit(x.get(pos + 2), x.get(pos + 1), x.get(pos), xm1);
+            Bits<64> row;
+            row.w[0] = ((m1.w[0] & fanOut(g.one)) | (m2.w[0] & fanOut(g.two)) |
+                        (m3.w[0] & fanOut(g.three)) | (m4.w[0] & fanOut(g.four))) ^ fanOut(g.neg);
+            wireShiftUp(row, pos, slot[d]);
+            negRow.put(pos, g.neg);
+        }
+        runTree(schedule(), slot);
+        const TreeSchedule& t = schedule();
+        int c = 0;
+        FinalAdder::add(slot[t.outA], slot[t.outB], prod, c);         // carry beyond 64 ignored
+    }
+};
@@ -0,0 +1,648 @@
+// netlist.h - gate-level netlists of the arithmetic units and a levelized word-parallel evaluator
+// NetBuilder records the same constructions the units run (fullAdder chains, the prefix
+// schedules of adders.h, the Booth digit logic and scheduled carry-save tree of multipliers.h,
+// the restoring divider array, the Float32 multiply datapath with roundPack32) as an explicit
+// DAG of NOT/AND/OR/XOR/MUX gates. Constants are folded and identical gates shared while
+// building; gates no output depends on are dropped at the end.
+// NetEval levelizes the DAG and runs batches of input vectors through it: every net holds
+// one bit of 64 vectors per word, so each gate is one word op per 64 vectors.
+#pragma once
+
+#include "numeric_ops.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// ============================= Netlist =============================
+enum GateOp : uint8_t { G_INPUT, G_ZERO, G_ONE, G_NOT, G_AND, G_OR, G_XOR, G_MUX, G_OPS };
+static const char* const kGateName[G_OPS] = { "input", "const0", "const1", "NOT", "AND", "OR", "XOR", "MUX" };
+
+// net i is driven by gates[i]; a gate only reads lower-numbered nets. MUX: a ? b : c.
+struct Gate { GateOp op; int a, b, c; };
+
+using Bus = vector<int>;   // net ids, LSB first (same order as Bits<N>::get positions)
+
+struct NetPort { string name; Bus nets; };
+
+struct Netlist {
+    vector<Gate> gates;
+    vector<NetPort> inputs, outputs;
+};
+
+// ============================= Builder =============================
+class NetBuilder {
+public:
+    NetBuilder() { add({ G_ZERO, 0, 0, 0 }); add({ G_ONE, 0, 0, 0 }); }
+
+    int zero() const { return 0; }
+    int one() const { return 1; }
+
+    Bus input(const string& name, int width) {
+        Bus b(width);
+        for (int i = 0; i < width; ++i) b[i] = add({ G_INPUT, 0, 0, 0 });
+        n.inputs.push_back({ name, b });
+        return b;
+    }
+    void output(const string& name, const Bus& b) { n.outputs.push_back({ name, b }); }
+
+    int inv(int a) {
+        if (a < 2) return 1 - a;
+        if (n.gates[a].op == G_NOT) return n.gates[a].a;
+        return hashed({ G_NOT, a, 0, 0 });
+    }
+    int and2(int a, int b) {
+        if (a > b) swap(a, b);
+        if (a == 0) return 0;
+        if (a == 1 || a == b) return b;
+        if (isInv(a, b)) return 0;
+        return hashed({ G_AND, a, b, 0 });
+    }
+    int or2(int a, int b) {
+        if (a > b) swap(a, b);
+        if (a == 1) return 1;
+        if (a == 0 || a == b) return b;
+        if (isInv(a, b)) return 1;
+        return hashed({ G_OR, a, b, 0 });
+    }
+    int xor2(int a, int b) {
+        if (a > b) swap(a, b);
+        if (a == b) return 0;
+        if (a == 0) return b;
+        if (a == 1) return inv(b);
+        if (isInv(a, b)) return 1;
+        return hashed({ G_XOR, a, b, 0 });
+    }
+    // s ? a : b
+    int mux(int s, int a, int b) {
+        if (s < 2) return s ? a : b;
+        if (a == b) return a;
+        if (a == 1 && b == 0) return s;
+        if (a == 0 && b == 1) return inv(s);
+        if (a == 0) return and2(inv(s), b);
+        if (b == 0) return and2(s, a);
+        if (a == 1) return or2(s, b);
+        if (b == 1) return or2(inv(s), a);
+        return hashed({ G_MUX, s, a, b });
+    }
+
+    // Drop gates no output reads and renumber (inputs keep their order).
+    Netlist finish() {
+        vector<char> live(n.gates.size(), 0);
+        live[0] = live[1] = 1;
+        for (const NetPort& p : n.inputs) for (int x : p.nets) live[x] = 1;
+        for (const NetPort& p : n.outputs) for (int x : p.nets) live[x] = 1;
+        for (int i = (int)n.gates.size() - 1; i >= 2; --i) {
+            if (!live[i]) continue;
+            const Gate& g = n.gates[i];
+            if (g.op >= G_NOT) live[g.a] = 1;
+            if (g.op >= G_AND) live[g.b] = 1;
+            if (g.op == G_MUX) live[g.c] = 1;
+        }
+        vector<int> id(n.gates.size(), -1);
+        Netlist out;
+        for (size_t i = 0; i < n.gates.size(); ++i) {
+            if (!live[i]) continue;
+            Gate g = n.gates[i];
+            if (g.op >= G_NOT) g.a = id[g.a];
+            if (g.op >= G_AND) g.b = id[g.b];
+            if (g.op == G_MUX) g.c = id[g.c];
+            id[i] = (int)out.gates.size();
+            out.gates.push_back(g);
+        }
+        for (NetPort p : n.inputs)  { for (int& x : p.nets) x = id[x]; out.inputs.push_back(p); }
+        for (NetPort p : n.outputs) { for (int& x : p.nets) x = id[x]; out.outputs.push_back(p); }
+        return out;
+    }
+
+private:
+    Netlist n;
+    // structural hashing: (op, a, b, c) -> net. The key holds every field exactly (32 bits per
+    // net id), so distinct gates never share a key; packing and mixing are bookkeeping on net
+    // ids, not modeled values.
+    struct GateKey {
+        uint64_t opA, bc;
+        bool operator==(const GateKey& o) const { return opA == o.opA && bc == o.bc; }
+    };
+    struct GateKeyHash {
+        size_t operator()(const GateKey& k) const {
+            uint64_t h = (k.opA * 0x9E3779B97F4A7C15ull) ^ k.bc;
+            h *= 0xBF58476D1CE4E5B9ull;
+            return (size_t)(h ^ (h >> 31));
+        }
+    };
+    unordered_map<GateKey, int, GateKeyHash> seen;
+
+    int add(const Gate& g) { n.gates.push_back(g); return (int)n.gates.size() - 1; }
+    bool isInv(int a, int b) const {
+        return (n.gates[a].op == G_NOT && n.gates[a].a == b) || (n.gates[b].op == G_NOT && n.gates[b].a == a);
+    }
+    int hashed(const Gate& g) {
+        GateKey key{ ((uint64_t)g.op << 32) | (uint32_t)g.a, ((uint64_t)(uint32_t)g.b << 32) | (uint32_t)g.c };
+        auto it = seen.find(key);
+        if (it != seen.end()) return it->second;
+        int id = add(g);
+        seen.emplace(key, id);
+        return id;
+    }
+};
+
+// ============================= Bus helpers (wiring and small blocks) =============================
+inline Bus constBus(uint64_t v, int width) { Bus b(width); for (int i = 0; i < width; ++i) b[i] = (v >> i) & 1; return b; }
+inline Bus slice(const Bus& x, int lo, int width) { Bus b(width, 0); for (int i = 0; i < width && lo + i < (int)x.size(); ++i) b[i] = x[lo + i]; return b; }
+inline Bus resized(const Bus& x, int width) { return slice(x, 0, width); }
+inline Bus routedUp(const Bus& x, int k) { Bus b(x.size(), 0); for (int i = k; i < (int)x.size(); ++i) b[i] = x[i - k]; return b; }
+
+inline Bus invBus(NetBuilder& nb, const Bus& x) { Bus b(x.size()); for (size_t i = 0; i < x.size(); ++i) b[i] = nb.inv(x[i]); return b; }
+inline Bus muxBus(NetBuilder& nb, int s, const Bus& a, const Bus& b) { Bus r(a.size()); for (size_t i = 0; i < a.size(); ++i) r[i] = nb.mux(s, a[i], b[i]); return r; }
+
+// balanced OR / AND trees
+inline int orReduce(NetBuilder& nb, Bus x) {
+    if (x.empty()) return nb.zero();
+    while (x.size() > 1) { Bus y; for (size_t i = 0; i + 1 < x.size(); i += 2) y.push_back(nb.or2(x[i], x[i + 1])); if (x.size() % 2) y.push_back(x.back()); x = y; }
+    return x[0];
+}
+inline int andReduce(NetBuilder& nb, Bus x) {
+    if (x.empty()) return nb.one();
+    while (x.size() > 1) { Bus y; for (size_t i = 0; i + 1 < x.size(); i += 2) y.push_back(nb.and2(x[i], x[i + 1])); if (x.size() % 2) y.push_back(x.back()); x = y; }
+    return x[0];
+}
+inline int equalsConst(NetBuilder& nb, const Bus& x, uint64_t v) {
+    Bus t(x.size()); for (size_t i = 0; i < x.size(); ++i) t[i] = (v >> i) & 1 ? x[i] : nb.inv(x[i]);
+    return andReduce(nb, t);
+}
+
+// ============================= Adders =============================
+// same gates as fullAdder(): sum = (a^b)^c, cout = (a&b)|(a&c)|(b&c)
+inline void netFullAdder(NetBuilder& nb, int a, int b, int c, int& sum, int& cout) {
+    int axb = nb.xor2(a, b);
+    sum = nb.xor2(axb, c);
+    cout = nb.or2(nb.or2(nb.and2(a, b), nb.and2(a, c)), nb.and2(b, c));
+}
+
+inline Bus netRipple(NetBuilder& nb, const Bus& A, const Bus& B, int cin, int& carry) {
+    Bus r(A.size());
+    for (size_t i = 0; i < A.size(); ++i) netFullAdder(nb, A[i], B[i], cin, r[i], cin);
+    carry = cin;
+    return r;
+}
+
+// a prefix schedule from adders.h, cell for cell (every cell of a step reads the step's inputs)
+template <int N, int S>
+inline Bus netPrefixAdd(NetBuilder& nb, const PrefixSchedule<N, S>& s, const Bus& A, const Bus& B, int& carry) {
+    Bus G(N), P(N), p(N), r(N);
+    for (int i = 0; i < N; ++i) { G[i] = nb.and2(A[i], B[i]); P[i] = nb.xor2(A[i], B[i]); }
+    p = P;
+    for (int t = 0; t < s.steps; ++t) {
+        Bus nG = G, nP = P;
+        for (int i = 0; i < N; ++i) {
+            if (!s.cells[t].get(i)) continue;
+            int j = i - s.dist[t];
+            nG[i] = nb.or2(G[i], nb.and2(P[i], G[j]));
+            nP[i] = nb.and2(P[i], P[j]);
+        }
+        G = nG; P = nP;
+    }
+    carry = G[N - 1];
+    r[0] = p[0];
+    for (int i = 1; i < N; ++i) r[i] = nb.xor2(p[i], G[i - 1]);
+    return r;
+}
+
+// NetAdder<Adder>::add<N> builds the adder struct of the same name
+template <class Adder>
+struct NetAdder {
+    template <int N>
+    static Bus add(NetBuilder& nb, const Bus& A, const Bus& B, int& carry) { return netPrefixAdd(nb, Adder::template schedule<N>(), A, B, carry); }
+};
+template <>
+struct NetAdder<RippleCarry> {
+    template <int N>
+    static Bus add(NetBuilder& nb, const Bus& A, const Bus& B, int& carry) { return netRipple(nb, A, B, nb.zero(), carry); }
+};
+template <>
+struct NetAdder<CarrySelect> {
+    template <int N>
+    static Bus add(NetBuilder& nb, const Bus& A, const Bus& B, int& carry) {
+        const int K = CarrySelect::kBlock;
+        Bus r(N);
+        int c = nb.zero();
+        for (int b = 0; b < N; b += K) {
+            int w = b + K < N ? K : N - b, k0, k1;
+            Bus a = slice(A, b, w), bb = slice(B, b, w);
+            Bus s0 = netRipple(nb, a, bb, nb.zero(), k0);
+            if (b == 0) { for (int i = 0; i < w; ++i) r[i] = s0[i]; c = k0; continue; }
+            Bus s1 = netRipple(nb, a, bb, nb.one(), k1);
+            for (int i = 0; i < w; ++i) r[b + i] = nb.mux(c, s1[i], s0[i]);
+            c = nb.mux(c, k1, k0);
+        }
+        carry = c;
+        return r;
+    }
+};
+
+template <class Adder, int N>
+inline Bus netAdd(NetBuilder& nb, const Bus& A, const Bus& B) { int c; return NetAdder<Adder>::template add<N>(nb, A, B, c); }
+
+// negateTwos: invert, then +1 through the adder (folding turns the +1 into an incrementer)
+template <class Adder, int N>
+inline Bus netNegate(NetBuilder& nb, const Bus& A) { return netAdd<Adder, N>(nb, invBus(nb, A), constBus(1, N)); }
+
+// ============================= ALU =============================
+// ALU(): opB = sub ? -b : b, one add, flags N Z C V
+inline void netALU(NetBuilder& nb) {
+    Bus a = nb.input("a", 32), b = nb.input("b", 32), sub = nb.input("sub", 1);
+    Bus opB = muxBus(nb, sub[0], netNegate<ALU_ADDER, 32>(nb, b), b);
+    int carry;
+    Bus sum = NetAdder<ALU_ADDER>::add<32>(nb, a, opB, carry);
+    int sa = a[31], sb = b[31], sr = sum[31];
+    int same = nb.inv(nb.xor2(sa, sb)), flip = nb.xor2(sr, sa);
+    int v = nb.mux(sub[0], nb.and2(nb.inv(same), flip), nb.and2(same, flip));
+    nb.output("result", sum);
+    nb.output("flags", { sr, nb.inv(orReduce(nb, sum)), carry, v });   // N Z C V
+}
+
+// ============================= Multipliers =============================
+// NetMul<Engine>::multiply builds MUL_ENGINE-style 32 x 32 -> 64 with signedness wires
+template <class Engine> struct NetMul;
+
+template <>
+struct NetMul<ShiftAddMul> {
+    static Bus multiply(NetBuilder& nb, const Bus& a, int aSigned, const Bus& b, int bSigned) {
+        int na = nb.and2(aSigned, a[31]), nbg = nb.and2(bSigned, b[31]);
+        Bus aa = muxBus(nb, na, netNegate<MUL_ADDER, 32>(nb, a), a);
+        Bus bb = muxBus(nb, nbg, netNegate<MUL_ADDER, 32>(nb, b), b);
+        Bus acc = constBus(0, 64), mc = resized(aa, 64);
+        for (int step = 0; step < 32; ++step) {
+            acc = muxBus(nb, bb[step], netAdd<MUL_ADDER, 64>(nb, acc, mc), acc);
+            mc = routedUp(mc, 1);
+        }
+        return muxBus(nb, nb.xor2(na, nbg), netNegate<MUL_ADDER, 64>(nb, acc), acc);
+    }
+};
+
+template <int Radix, class Tree, class FinalAdder>
+struct NetMul<BoothMul<Radix, Tree, FinalAdder>> {
+    using M = BoothMul<Radix, Tree, FinalAdder>;
+    static Bus extend(NetBuilder& nb, const Bus& x, int isSigned, int width) {
+        Bus y = resized(x, width);
+        int s = nb.and2(isSigned, x[31]);
+        for (int i = 32; i < width; ++i) y[i] = s;
+        return y;
+    }
+    static Bus multiply(NetBuilder& nb, const Bus& a, int aSigned, const Bus& b, int bSigned) {
+        Bus m1 = extend(nb, a, aSigned, 64), m2 = routedUp(m1, 1), m3 = constBus(0, 64), m4 = constBus(0, 64);
+        if (Radix == 8) { m3 = netAdd<FinalAdder, 64>(nb, m1, m2); m4 = routedUp(m1, 2); }
+        Bus x = extend(nb, b, bSigned, M::kDigits * M::kDigitBits);
+
+        vector<Bus> slot(kMaxMulSlots, constBus(0, 64));
+        Bus& negRow = slot[M::kDigits];
+        for (int d = 0, pos = 0; d < M::kDigits; ++d, pos += M::kDigitBits) {
+            int x0 = pos ? x[pos - 1] : nb.zero(), neg, one, two, three = 0, four = 0;
+            if (Radix == 4) {                            // booth4Digit
+                int x2 = x[pos + 1], x1 = x[pos];
+                int y1 = nb.xor2(x1, x2), y0 = nb.xor2(x0, x2);
+                neg = nb.and2(x2, nb.inv(nb.and2(x1, x0)));
+                one = nb.xor2(y1, y0); two = nb.and2(y1, y0);
+            } else {                                     // booth8Digit
+                int x3 = x[pos + 2], x2 = x[pos + 1], x1 = x[pos];
+                int y2 = nb.xor2(x2, x3), y1 = nb.xor2(x1, x3), y0 = nb.xor2(x0, x3);
+                neg = nb.and2(x3, nb.inv(nb.and2(nb.and2(x2, x1), x0)));
+                one = nb.and2(nb.inv(y2), nb.xor2(y1, y0));
+                two = nb.or2(nb.and2(nb.and2(nb.inv(y2), y1), y0), nb.and2(nb.and2(y2, nb.inv(y1)), nb.inv(y0)));
+                three = nb.and2(y2, nb.xor2(y1, y0));
+                four = nb.and2(nb.and2(y2, y1), y0);
+            }
+            Bus row(64);
+            for (int k = 0; k < 64; ++k)
+                row[k] = nb.xor2(nb.or2(nb.or2(nb.and2(m1[k], one), nb.and2(m2[k], two)),
+                                        nb.or2(nb.and2(m3[k], three), nb.and2(m4[k], four))), neg);
+            slot[d] = routedUp(row, pos);
+            negRow[pos] = neg;
+        }
+        const TreeSchedule& t = M::schedule();
+        for (int i = 0; i < t.ops; ++i) {                // runTree: a row of 3:2 counters per op
+            const CsaOp& o = t.op[i];
+            Bus s(64), k(64);
+            for (int j = 0; j < 64; ++j) netFullAdder(nb, slot[o.a][j], slot[o.b][j], slot[o.c][j], s[j], k[j]);
+            slot[o.sum] = s; slot[o.carry] = routedUp(k, 1);
+        }
+        return netAdd<FinalAdder, 64>(nb, slot[t.outA], slot[t.outB]);
+    }
+};
+
+// mul_ss / mul_su / mul_uu in one circuit: the signedness of each operand is an input
+inline void netMultiplier(NetBuilder& nb) {
+    Bus a = nb.input("a", 32), b = nb.input("b", 32), sa = nb.input("aSigned", 1), sb = nb.input("bSigned", 1);
+    nb.output("prod", NetMul<MUL_ENGINE>::multiply(nb, a, sa[0], b, sb[0]));
+}
+
+// ============================= Divider =============================
+// divu_restoring: the 32-row restoring array (DIV_ADDER) plus the x / 0 override
+inline void netDivider(NetBuilder& nb) {
+    Bus n = nb.input("dividend", 32), d = nb.input("divisor", 32);
+    Bus negD = netNegate<DIV_ADDER, 32>(nb, d), R = constBus(0, 32), Q(32);
+    for (int i = 0; i < 32; ++i) {
+        R = routedUp(R, 1); R[0] = n[31 - i];
+        int noBorrow;
+        Bus diff = NetAdder<DIV_ADDER>::add<32>(nb, R, negD, noBorrow);
+        R = muxBus(nb, noBorrow, diff, R);
+        Q[31 - i] = noBorrow;
+    }
+    int dz = nb.inv(orReduce(nb, d));
+    nb.output("q", muxBus(nb, dz, constBus(0xFFFFFFFFu, 32), Q));
+    nb.output("r", muxBus(nb, dz, n, R));
+}
+
+// ============================= Float32 multiply =============================
+// tree leading-zero count of a power-of-two-wide bus: (all zero, count)
+inline void netLeadingZeros(NetBuilder& nb, const Bus& x, int& allZero, Bus& count) {
+    if (x.size() == 1) { allZero = nb.inv(x[0]); count.clear(); return; }
+    int h = (int)x.size() / 2, zHi, zLo; Bus cHi, cLo;
+    netLeadingZeros(nb, slice(x, h, h), zHi, cHi);
+    netLeadingZeros(nb, slice(x, 0, h), zLo, cLo);
+    allZero = nb.and2(zHi, zLo);
+    count = muxBus(nb, zHi, cLo, cHi);
+    count.push_back(zHi);
+}
+
+// logarithmic shifter toward the MSB by the value of k
+inline Bus netShiftUp(NetBuilder& nb, Bus x, const Bus& k) {
+    for (size_t j = 0; j < k.size(); ++j) x = muxBus(nb, k[j], routedUp(x, 1 << j), x);
+    return x;
+}
+
+// logarithmic shifter toward the LSB; every wire routed off the bottom is ORed into wire 0
+inline Bus netShiftRightJam(NetBuilder& nb, Bus x, const Bus& k) {
+    int w = (int)x.size(), sticky = nb.zero();
+    for (size_t j = 0; j < k.size(); ++j) {
+        int d = 1 << j;
+        Bus moved = slice(x, d, w);
+        int lost = orReduce(nb, slice(x, 0, d < w ? d : w));
+        sticky = nb.or2(sticky, nb.and2(k[j], lost));
+        x = muxBus(nb, k[j], moved, x);
+    }
+    x[0] = nb.or2(x[0], sticky);
+    return x;
+}
+
+// roundPack32 (numeric_ops.h), rm = RoundingMode wires
+inline Bus netRoundPack32(NetBuilder& nb, int sign, Bus exp, Bus sig, const Bus& rm) {
+    int rne = equalsConst(nb, rm, 0), rdn = equalsConst(nb, rm, 2), rup = equalsConst(nb, rm, 3), rmm = equalsConst(nb, rm, 4);
+    int low = nb.or2(exp[9], nb.inv(orReduce(nb, exp)));            // exp <= 0
+    Bus k = netAdd<FLOAT_ADDER, 10>(nb, netNegate<FLOAT_ADDER, 10>(nb, exp), constBus(1, 10));   // 1 - exp
+    Bus shifted = netShiftRightJam(nb, sig, slice(k, 0, 9));
+    sig = muxBus(nb, low, shifted, sig);
+    int ovfIn = nb.and2(nb.inv(low), exp[8]);                        // exp >= 256
+    exp = muxBus(nb, low, constBus(1, 10), exp);
+    int ovf255 = equalsConst(nb, exp, 255);
+
+    int g = sig[2], r = sig[1], s = sig[0], lsb = sig[3];
+    int inexact = nb.or2(nb.or2(g, r), s);
+    int inc = nb.or2(nb.or2(nb.and2(rne, nb.and2(g, nb.or2(nb.or2(r, s), lsb))),
+                            nb.and2(rdn, nb.and2(sign, inexact))),
+                     nb.or2(nb.and2(rup, nb.and2(nb.inv(sign), inexact)), nb.and2(rmm, g)));
+    Bus em1 = netAdd<FLOAT_ADDER, 10>(nb, exp, constBus(0x3FF, 10));
+    Bus packed = constBus(0, 31);
+    for (int i = 0; i < 8; ++i) packed[23 + i] = em1[i];
+    packed = netAdd<FLOAT_ADDER, 31>(nb, packed, resized(slice(sig, 3, 24), 31));
+    Bus incBus = constBus(0, 31); incBus[0] = inc;
+    packed = netAdd<FLOAT_ADDER, 31>(nb, packed, incBus);
+    int ovfOut = andReduce(nb, slice(packed, 23, 8));
+
+    int toInf = nb.or2(nb.or2(rne, rmm), nb.or2(nb.and2(rup, nb.inv(sign)), nb.and2(rdn, sign)));
+    Bus big = muxBus(nb, toInf, constBus(0x7F800000u, 31), constBus(0x7F7FFFFFu, 31));
+    Bus out = muxBus(nb, nb.or2(nb.or2(ovfIn, ovf255), ovfOut), big, packed);
+    out.push_back(sign);
+    return out;
+}
+
+// floatMultiply: specials, 10-bit exponent bus, MUL_ENGINE significand product,
+// leading-zero normalization, sticky, roundPack32
+inline void netFloatMultiply(NetBuilder& nb) {
+    Bus a = nb.input("a", 32), b = nb.input("b", 32), rm = nb.input("rm", 3);
+    struct Side { int sign, zero, inf, nan; Bus e, m; } s[2];
+    const Bus* in[2] = { &a, &b };
+    for (int i = 0; i < 2; ++i) {
+        const Bus& x = *in[i];
+        Bus ex = slice(x, 23, 8), fr = slice(x, 0, 23);
+        int eZero = nb.inv(orReduce(nb, ex)), eOnes = andReduce(nb, ex), fZero = nb.inv(orReduce(nb, fr));
+        s[i].sign = x[31];
+        s[i].zero = nb.and2(eZero, fZero); s[i].inf = nb.and2(eOnes, fZero); s[i].nan = nb.and2(eOnes, nb.inv(fZero));
+        s[i].e = resized(ex, 10); s[i].e[0] = nb.or2(ex[0], eZero);     // subnormals use exponent 1
+        s[i].m = resized(fr, 32); s[i].m[23] = nb.inv(eZero);
+    }
+    int sign = nb.xor2(s[0].sign, s[1].sign);
+    int isNaN = nb.or2(nb.or2(s[0].nan, s[1].nan), nb.or2(nb.and2(s[0].inf, s[1].zero), nb.and2(s[0].zero, s[1].inf)));
+    int isInf = nb.or2(s[0].inf, s[1].inf);
+    int isZero = nb.or2(s[0].zero, s[1].zero);
+
+    Bus exp = netAdd<FLOAT_ADDER, 10>(nb, s[0].e, s[1].e);
+    exp = netAdd<FLOAT_ADDER, 10>(nb, exp, constBus(0x3FF & (uint64_t)-126, 10));
+    Bus prod = NetMul<MUL_ENGINE>::multiply(nb, s[0].m, nb.zero(), s[1].m, nb.zero());
+
+    Bus p48 = resized(prod, 48), lz; int allZero;
+    netLeadingZeros(nb, routedUp(resized(p48, 64), 16), allZero, lz);   // 48 wires at the top of 64
+    p48 = netShiftUp(nb, p48, lz);
+    exp = netAdd<FLOAT_ADDER, 10>(nb, exp, netNegate<FLOAT_ADDER, 10>(nb, resized(lz, 10)));
+    Bus sig = slice(p48, 21, 27);
+    sig[0] = nb.or2(sig[0], orReduce(nb, slice(p48, 0, 21)));
+    Bus out = netRoundPack32(nb, sign, exp, sig, rm);
+
+    Bus signedZero = constBus(0, 32); signedZero[31] = sign;
+    Bus signedInf = constBus(0x7F800000u, 32); signedInf[31] = sign;
+    out = muxBus(nb, isZero, signedZero, out);
+    out = muxBus(nb, isInf, signedInf, out);
+    out = muxBus(nb, isNaN, constBus(0x7FC00000u, 32), out);
+    nb.output("result", out);
+}
+
+// ============================= Levelized evaluator =============================
+constexpr int kNetWords = 16;  // words per net per pass: 1024 vectors
+
+struct NetStats {
+    int count[G_OPS] = {};
+    int gates2 = 0;            // 2-input gate equivalents: AND/OR/XOR 1, MUX 3, NOT free (adders.h cost model)
+    int levels = 0;            // evaluation levels (every gate one level)
+    int depth = 0;             // critical path in gate delays: AND/OR/XOR 1, MUX 2, NOT 0
+    string criticalOutput;     // port[bit] at the end of the critical path
+    int pathCount[G_OPS] = {}; // gate types along that path
+};
+
+class NetEval {
+public:
+    explicit NetEval(const Netlist& n) : nl(n) { levelize(); }
+
+    const NetStats& stats() const { return st; }
+    const Netlist& netlist() const { return nl; }
+
+    // in[p] / out[p]: port p bit-sliced, [bit][word] with 64 vectors per word (words = ceil(vectors / 64)).
+    // Threads take blocks of kNetWords words. toggles (optional) receives, per gate type,
+    // how many times its nets changed between consecutive vectors.
+    void run(const vector<vector<uint64_t>>& in, vector<vector<uint64_t>>& out, size_t vectors,
+             unsigned threads = 1, uint64_t* toggles = nullptr) const {
+        size_t words = (vectors + 63) / 64, blocks = (words + kNetWords - 1) / kNetWords;
+        out.resize(nl.outputs.size());
+        for (size_t p = 0; p < nl.outputs.size(); ++p) out[p].assign(nl.outputs[p].nets.size() * words, 0);
+        atomic<size_t> next{0};
+        vector<vector<uint64_t>> tog(threads, vector<uint64_t>(G_OPS, 0));
+        auto work = [&](unsigned id) {
+            vector<uint64_t> v(order.size() * kNetWords);
+            for (;;) {
+                size_t blk = next.fetch_add(1);
+                if (blk >= blocks) break;
+                size_t w0 = blk * kNetWords, nw = min((size_t)kNetWords, words - w0);
+                for (size_t p = 0; p < nl.inputs.size(); ++p)
+                    for (size_t i = 0; i < nl.inputs[p].nets.size(); ++i) {
+                        uint64_t* dst = &v[slotOf[nl.inputs[p].nets[i]] * kNetWords];
+                        const uint64_t* src = &in[p][i * words + w0];
+                        for (size_t w = 0; w < kNetWords; ++w) dst[w] = w < nw ? src[w] : 0;
+                    }
+                evalBlock(v.data());
+                for (size_t p = 0; p < nl.outputs.size(); ++p)
+                    for (size_t i = 0; i < nl.outputs[p].nets.size(); ++i) {
+                        const uint64_t* src = &v[slotOf[nl.outputs[p].nets[i]] * kNetWords];
+                        for (size_t w = 0; w < nw; ++w) out[p][i * words + w0 + w] = src[w];
+                    }
+                if (toggles) countToggles(v.data(), nw, w0 + nw == words ? vectors - w0 * 64 : nw * 64, tog[id].data());
+            }
+        };
+        vector<thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work, t);
+        work(0);
+        for (thread& t : pool) t.join();
+        if (toggles) for (int k = 0; k < G_OPS; ++k) { toggles[k] = 0; for (auto& t : tog) toggles[k] += t[k]; }
+    }
+
+private:
+    Netlist nl;
+    NetStats st;
+    vector<int> order;          // slot -> net, in level order
+    vector<int> slotOf;         // net -> slot
+    struct Run { GateOp op; int begin, end; };
+    vector<Run> runs;           // same-op slot ranges, level by level
+    vector<int> ra, rb, rc;     // input slots per slot
+
+    void levelize() {
+        size_t n = nl.gates.size();
+        vector<int> level(n, 0), delay(n, 0), from(n, -1);
+        for (size_t i = 0; i < n; ++i) {
+            const Gate& g = nl.gates[i];
+            st.count[g.op]++;
+            if (g.op < G_NOT) continue;
+            int ins[3] = { g.a, g.op >= G_AND ? g.b : g.a, g.op == G_MUX ? g.c : g.a };
+            int lv = 0, dl = -1;
+            for (int x : ins) {
+                lv = max(lv, level[x]);
+                if (delay[x] > dl) { dl = delay[x]; from[i] = x; }
+            }
+            level[i] = lv + 1;
+            delay[i] = dl + (g.op == G_NOT ? 0 : g.op == G_MUX ? 2 : 1);
+            st.levels = max(st.levels, level[i]);
+        }
+        st.gates2 = st.count[G_AND] + st.count[G_OR] + st.count[G_XOR] + 3 * st.count[G_MUX];
+
+        // critical path: the slowest output wire, walked back through the slowest inputs
+        int end = -1;
+        for (const NetPort& p : nl.outputs)
+            for (size_t i = 0; i < p.nets.size(); ++i)
+                if (end < 0 || delay[p.nets[i]] > delay[end]) { end = p.nets[i]; st.criticalOutput = p.name + "[" + to_string(i) + "]"; }
+        if (end >= 0) {
+            st.depth = delay[end];
+            for (int x = end; x >= 0 && nl.gates[x].op >= G_NOT; x = from[x]) st.pathCount[nl.gates[x].op]++;
+        }
+
+        // slots: sorted by (level, op) so every run is one op over independent gates
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) order[i] = (int)i;
+        stable_sort(order.begin(), order.end(), [&](int x, int y) {
+            return level[x] != level[y] ? level[x] < level[y] : nl.gates[x].op < nl.gates[y].op;
+        });
+        slotOf.assign(n, 0);
+        for (size_t s = 0; s < n; ++s) slotOf[order[s]] = (int)s;
+        ra.assign(n, 0); rb.assign(n, 0); rc.assign(n, 0);
+        for (size_t s = 0; s < n; ++s) {
+            const Gate& g = nl.gates[order[s]];
+            ra[s] = slotOf[g.a]; rb[s] = slotOf[g.b]; rc[s] = slotOf[g.c];
+            if (runs.empty() || runs.back().op != g.op || level[order[runs.back().begin]] != level[order[s]])
+                runs.push_back({ g.op, (int)s, (int)s + 1 });
+            else runs.back().end = (int)s + 1;
+        }
+    }
+
+    void evalBlock(uint64_t* v) const {
+        const int W = kNetWords;
+        for (const Run& r : runs) {
+            switch (r.op) {
+            case G_ZERO: for (int s = r.begin; s < r.end; ++s) for (int w = 0; w < W; ++w) v[s * W + w] = 0; break;
+            case G_ONE:  for (int s = r.begin; s < r.end; ++s) for (int w = 0; w < W; ++w) v[s * W + w] = ~(uint64_t)0; break;
+            case G_NOT:  for (int s = r.begin; s < r.end; ++s) { const uint64_t* a = v + ra[s] * W; for (int w = 0; w < W; ++w) v[s * W + w] = ~a[w]; } break;
+            case G_AND:  for (int s = r.begin; s < r.end; ++s) { const uint64_t *a = v + ra[s] * W, *b = v + rb[s] * W; for (int w = 0; w < W; ++w) v[s * W + w] = a[w] & b[w]; } break;
+            case G_OR:   for (int s = r.begin; s < r.end; ++s) { const uint64_t *a = v + ra[s] * W, *b = v + rb[s] * W; for (int w = 0; w < W; ++w) v[s * W + w] = a[w] | b[w]; } break;
+            case G_XOR:  for (int s = r.begin; s < r.end; ++s) { const uint64_t *a = v + ra[s] * W, *b = v + rb[s] * W; for (int w = 0; w < W; ++w) v[s * W + w] = a[w] ^ b[w]; } break;
+            case G_MUX:
+                for (int s = r.begin; s < r.end; ++s) {
+                    const uint64_t *m = v + ra[s] * W, *a = v + rb[s] * W, *b = v + rc[s] * W;
+                    for (int w = 0; w < W; ++w) v[s * W + w] = (m[w] & a[w]) | (~m[w] & b[w]);
+                }
+                break;
+            default: break;   // inputs are loaded by run()
+            }
+        }
+    }
+
+    // changes between consecutive vectors (lane i -> i+1, across words too) of every net in the block
+    void countToggles(const uint64_t* v, size_t nw, size_t lanes, uint64_t* tog) const {
+        for (size_t s = 0; s < order.size(); ++s) {
+            const uint64_t* x = v + s * kNetWords;
+            uint64_t t = 0;
+            for (size_t w = 0; w < nw; ++w) {
+                size_t live = min((size_t)64, lanes - w * 64);                // lanes holding vectors
+                uint64_t diff = x[w] ^ (x[w] >> 1);                           // lane i vs lane i+1
+                uint64_t mask = live >= 64 ? ~(uint64_t)0 >> 1 : (((uint64_t)1 << live) - 1) >> 1;
+                t += __builtin_popcountll(diff & mask);
+                if (live == 64 && w + 1 < nw) t += ((x[w] >> 63) ^ x[w + 1]) & 1;
+            }
+            tog[nl.gates[order[s]].op] += t;
+        }
+    }
+};
+
+// ---- batch I/O (TEST side: host shifts fine) ----
+// in-place 64x64 bit transpose: bit j of m[i] <-> bit i of m[j]
+inline void transpose64(uint64_t m[64]) {
+    uint64_t mask = 0x00000000FFFFFFFFull;
+    for (int j = 32; j; j >>= 1, mask ^= mask << j)
+        for (int k = 0; k < 64; k = (k + j + 1) & ~j) {
+            uint64_t t = ((m[k] >> j) ^ m[k + j]) & mask;
+            m[k] ^= t << j; m[k + j] ^= t;
+        }
+}
+// values[i] (low `width` bits) of vector i -> port layout [bit][word]
+inline vector<uint64_t> sliceIn(const vector<uint64_t>& values, int width) {
+    size_t words = (values.size() + 63) / 64;
+    vector<uint64_t> s(width * words, 0);
+    uint64_t m[64];
+    for (size_t w = 0; w < words; ++w) {
+        for (size_t i = 0; i < 64; ++i) m[i] = w * 64 + i < values.size() ? values[w * 64 + i] : 0;
+        transpose64(m);
+        for (int b = 0; b < width; ++b) s[b * words + w] = m[b];
+    }
+    return s;
+}
+// port layout [bit][word] -> one value per vector
+inline vector<uint64_t> sliceOut(const vector<uint64_t>& s, int width, size_t vectors) {
+    size_t words = (vectors + 63) / 64;
+    vector<uint64_t> values(vectors);
+    uint64_t m[64];
+    for (size_t w = 0; w < words; ++w) {
+        for (int b = 0; b < 64; ++b) m[b] = b < width ? s[b * words + w] : 0;
+        transpose64(m);
+        for (size_t i = 0; i < 64 && w * 64 + i < vectors; ++i) values[w * 64 + i] = m[i];
+    }
+    return values;
+}
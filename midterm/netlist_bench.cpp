@@ -0,0 +1,156 @@
+// netlist_bench.cpp - gate netlists of the units: size, critical path, switching activity, batch speed
+// Build: g++ -O2 -std=c++17 -pthread netlist_bench.cpp -o netlist_bench
+//        (-DALU_ADDER=... / -DMUL_ENGINE=... / -DDIV_ADDER=... / -DFLOAT_ADDER=... pick the circuits)
+// Usage: netlist_bench [vectors] [threads]
+// Every circuit is built from the same construction as its unit, evaluated on random vectors
+// (64 per word, kNetWords words per pass) and checked vector by vector against the per-op code.
+#include "netlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+static double nowNs(){ return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+static uint64_t maskOf(int width){ return width >= 64 ? ~0ull : (1ull << width) - 1; }
+
+static void printStats(const char* name, const NetStats& s){
+    printf("%-8s %7d gates2 (AND %d OR %d XOR %d MUX %d NOT %d), %4d levels, depth %4d at %s\n", name, s.gates2,
+           s.count[G_AND], s.count[G_OR], s.count[G_XOR], s.count[G_MUX], s.count[G_NOT], s.levels, s.depth, s.criticalOutput.c_str());
+    printf("%-8s critical path: %d AND, %d OR, %d XOR, %d MUX, %d NOT\n", "", s.pathCount[G_AND], s.pathCount[G_OR],
+           s.pathCount[G_XOR], s.pathCount[G_MUX], s.pathCount[G_NOT]);
+}
+
+// in: one value per input port; out: one value per output port (host values, TEST side)
+using Reference = function<void(const uint64_t* in, uint64_t* out)>;
+
+static void circuit(const char* name, void (*build)(NetBuilder&), size_t n, unsigned threads,
+                    const function<uint64_t(int port)>& gen, const Reference& ref){
+    NetBuilder nb; build(nb);
+    NetEval ev(nb.finish());
+    const Netlist& nl = ev.netlist();
+    printStats(name, ev.stats());
+
+    size_t ni = nl.inputs.size(), no = nl.outputs.size();
+    vector<vector<uint64_t>> vals(ni, vector<uint64_t>(n)), in(ni), out;
+    for(size_t i=0;i<n;++i) for(size_t p=0;p<ni;++p) vals[p][i] = gen((int)p) & maskOf((int)nl.inputs[p].nets.size());
+    double t0 = nowNs();
+    for(size_t p=0;p<ni;++p) in[p] = sliceIn(vals[p], (int)nl.inputs[p].nets.size());
+    double tPack = nowNs() - t0;
+
+    uint64_t tog[G_OPS];
+    ev.run(in, out, n, 1, tog);                  // activity pass (also warms up)
+    t0 = nowNs(); ev.run(in, out, n, 1);          double t1 = nowNs() - t0;
+    t0 = nowNs(); ev.run(in, out, n, threads);    double tT = nowNs() - t0;
+
+    vector<vector<uint64_t>> got(no);
+    for(size_t p=0;p<no;++p) got[p] = sliceOut(out[p], (int)nl.outputs[p].nets.size(), n);
+    vector<uint64_t> iv(ni), want(no);
+    size_t bad = 0;
+    double tRef = 0;
+    for(size_t i=0;i<n;++i){
+        for(size_t p=0;p<ni;++p) iv[p] = vals[p][i];
+        t0 = nowNs(); ref(iv.data(), want.data()); tRef += nowNs() - t0;
+        for(size_t p=0;p<no;++p)
+            if(got[p][i] != want[p]){
+                if(!bad){
+                    printf("%-8s MISMATCH at vector %zu, port %s:", "", i, nl.outputs[p].name.c_str());
+                    for(size_t q=0;q<ni;++q) printf(" %s=%llx", nl.inputs[q].name.c_str(), (unsigned long long)iv[q]);
+                    printf(" got %llx want %llx\n", (unsigned long long)got[p][i], (unsigned long long)want[p]);
+                }
+                bad++;
+            }
+    }
+
+    const NetStats& s = ev.stats();
+    printf("%-8s activity:", "");
+    for(int k=G_NOT;k<G_OPS;++k)
+        if(s.count[k]) printf(" %s %.3f", kGateName[k], (double)tog[k] / ((double)s.count[k] * (double)(n - 1)));
+    printf("\n%-8s per-op %8.1f ns | netlist %7.2f ns/vec (1 thread) %7.2f ns/vec (%u threads), slicing %5.2f ns/vec | x%.0f | %s\n\n",
+           "", tRef/n, t1/n, tT/n, threads, tPack/n, tRef/tT, bad ? "MISMATCH" : "ok");
+}
+
+// every adder of adders.h at 32 bits: the netlist against the cost model and the unit itself
+template <class Adder>
+static void adderRow(size_t n){
+    NetBuilder nb;
+    Bus a = nb.input("a", 32), b = nb.input("b", 32);
+    int c; Bus sum = NetAdder<Adder>::template add<32>(nb, a, b, c);
+    sum.push_back(c);
+    nb.output("sum", sum);
+    NetEval ev(nb.finish());
+    vector<uint64_t> va(n), vb(n);
+    for(size_t i=0;i<n;++i){ va[i] = (uint32_t)rnd64(); vb[i] = (uint32_t)rnd64(); }
+    vector<vector<uint64_t>> in = { sliceIn(va, 32), sliceIn(vb, 32) }, out;
+    ev.run(in, out, n);
+    vector<uint64_t> got = sliceOut(out[0], 33, n);
+    size_t bad = 0;
+    for(size_t i=0;i<n;++i){
+        Bits<32> r; int k = 0; Adder::add(intToBits((long long)va[i]), intToBits((long long)vb[i]), r, k);
+        if(got[i] != (r.w[0] | (uint64_t)k << 32)) bad++;
+    }
+    AdderCost m = Adder::template cost<32>();
+    const NetStats& s = ev.stats();
+    printf("%-30s %6d %6d %6d %6d  %s\n", Adder::name(), s.gates2, m.gates, s.depth, m.depth, bad ? "MISMATCH" : "ok");
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 20000;
+    unsigned threads = argc > 2 ? (unsigned)atoi(argv[2]) : thread::hardware_concurrency();
+    if(n < 2) n = 2;
+    if(!threads) threads = 1;
+
+    printf("32-bit adders (netlist after folding vs adders.h cost model)\n");
+    printf("%-30s %6s %6s %6s %6s\n", "adder", "gates", "model", "depth", "model");
+    adderRow<RippleCarry>(4096); adderRow<CarryLookahead>(4096); adderRow<KoggeStone>(4096);
+    adderRow<BrentKung>(4096); adderRow<HanCarlson>(4096); adderRow<CarrySelect>(4096);
+
+    printf("\n%zu vectors per circuit; ALU %s, MUL %s (%s), DIV restoring (%s), FLOAT %s\n\n", n,
+           ALU_ADDER::name(), MUL_ENGINE::name(), MUL_ADDER::name(), DIV_ADDER::name(), FLOAT_ADDER::name());
+
+    circuit("alu", netALU, n, threads, [](int p){ return p == 2 ? rnd64() & 1 : rnd64(); },
+        [](const uint64_t* in, uint64_t* out){
+            ALUResult r; ALU(intToBits((long long)in[0]), intToBits((long long)in[1]), in[2] != 0, r);
+            out[0] = r.result.w[0];
+            out[1] = (uint64_t)r.flags.N | (uint64_t)r.flags.Z << 1 | (uint64_t)r.flags.C << 2 | (uint64_t)r.flags.V << 3;
+        });
+
+    // mul_ss / mul_su / mul_uu: (aSigned, bSigned) = (1,1) (1,0) (0,0)
+    static uint64_t mulKind = 0;
+    circuit("mul", netMultiplier, n, threads,
+        [](int p){ if(p == 2) mulKind = rnd64() % 3; return p < 2 ? rnd64() : p == 2 ? (uint64_t)(mulKind < 2) : (uint64_t)(mulKind == 0); },
+        [](const uint64_t* in, uint64_t* out){
+            MulOut m; Bits<32> a = intToBits((long long)in[0]), b = intToBits((long long)in[1]);
+            if(in[2] && in[3]) mul_ss(a, b, m, false); else if(in[2]) mul_su(a, b, m, false); else mul_uu(a, b, m, false);
+            out[0] = m.high32.w[0] << 32 | m.low32.w[0];
+        });
+
+    // dividends full width, divisors of every length (and some zeros)
+    circuit("divu", netDivider, n, threads,
+        [](int p){ uint64_t x = rnd64(); return p == 0 ? x : (x % 16 == 0 ? 0 : x >> (32 + x % 32)); },
+        [](const uint64_t* in, uint64_t* out){
+            DivOut d; divu_restoring(intToBits((long long)in[0]), intToBits((long long)in[1]), d, false);
+            out[0] = d.q.w[0]; out[1] = d.r.w[0];
+        });
+
+    // finite operands of every exponent, every 8th subnormal, some specials; all five rounding modes
+    circuit("fmul", netFloatMultiply, n, threads,
+        [](int p){
+            uint64_t x = rnd64();
+            if(p == 2) return x % 5;
+            uint32_t u = (uint32_t)x;
+            if(x >> 61 == 0) u &= 0x807FFFFFu;
+            else if(x >> 58 == 8) u = (uint32_t)(x >> 32) % 2 ? 0x7F800000u : 0;
+            return (uint64_t)u;
+        },
+        [](const uint64_t* in, uint64_t* out){
+            Bits<32> r; floatMultiply(intToBits((long long)in[0]), intToBits((long long)in[1]), r, (RoundingMode)in[2]);
+            out[0] = r.w[0];
+        });
+    return 0;
+}
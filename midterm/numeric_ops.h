@@ -0,0 +1,575 @@
+// numeric_ops.h - RISC-V numeric ops simulator: bit-level ALU, MUL/DIV and Float32 units
+// Shared by the demo in midterm.cpp and the other drivers in this folder.
+#pragma once
+
+#include "adders.h"
+#include "dividers.h"
+#include "multipliers.h"
+#include "shifters.h"
+#include "trace.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// ---- adder selection per unit (compile-time; any adder struct from adders.h) ----
+// e.g. g++ -DMUL_ADDER=KoggeStone ...
+#ifndef ALU_ADDER
+#define ALU_ADDER RippleCarry
+#endif
+#ifndef MUL_ADDER
+#define MUL_ADDER RippleCarry
+#endif
+#ifndef DIV_ADDER
+#define DIV_ADDER RippleCarry
+#endif
+#ifndef FLOAT_ADDER
+#define FLOAT_ADDER RippleCarry
+#endif
+// MUL engine: ShiftAddMul (default) or Booth4Wallace/Booth4Dadda/Booth8Wallace/Booth8Dadda
+// (the Dadda engines use Dadda's heights as a whole-row schedule; see multipliers.h)
+#ifndef MUL_ENGINE
+#define MUL_ENGINE ShiftAddMul
+#endif
+// DIV engine: RestoringDiv (default), NonRestoringDivider or Srt4Divider
+#ifndef DIV_ENGINE
+#define DIV_ENGINE RestoringDiv
+#endif
+// Float divide/sqrt engine (float_divsqrt.h): NewtonRaphsonFp, GoldschmidtFp or DigitRecurrenceFp
+#ifndef FLOAT_DIV_ENGINE
+#define FLOAT_DIV_ENGINE DigitRecurrenceFp
+#endif
+
+// ============================= Section 1: Core Implementation (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---- shifters (no << >> on values: one-wire moves) ----
+template <int N>
+inline void shiftLeft1(const Bits<N>& x,Bits<N>& y){ wireShiftUp(x,1,y); }
+
+template <int N>
+inline void shiftRight1Logical(const Bits<N>& x,Bits<N>& y){ wireShiftDown(x,1,y); }
+
+template <int N>
+inline void shiftRight1Arithmetic(const Bits<N>& x,Bits<N>& y){
+    int s = x[0];
+    wireShiftDown(x,1,y);
+    y.set(0,s);
+}
+
+// ---- utils ----
+template <int N> inline int signBit(const Bits<N>& x){ return x[0]; }
+template <int N> inline int isZeroBits(const Bits<N>& x){ for(int j=0;j<Bits<N>::W;++j) if(x.w[j]) return 0; return 1; }
+template <class Adder = RippleCarry, int N> inline void absSigned(const Bits<N>& x,Bits<N>& y){ if(signBit(x)) negateTwos<Adder>(x,y); else y=x; }
+
+// ---- extend/compare ----
+template <int N,int M>
+inline void zeroExtend(const Bits<N>& x,Bits<M>& y){
+    static_assert(M >= N, "zeroExtend cannot narrow");
+    resizeBits(x,y);
+}
+
+template <int N,int M>
+inline void signExtendTo(const Bits<N>& x,Bits<M>& y){
+    static_assert(M >= N, "signExtendTo cannot narrow");
+    int s = x[0];
+    resizeBits(x,y);
+    if(s){ Bits<M> hi = ones<M>(); wireShiftUp(hi,N,hi); for(int j=0;j<Bits<M>::W;++j) y.w[j] |= hi.w[j]; }
+}
+
+// -1 / 0 / 1, most significant byte first through the 8-bit compare slices
+template <int N>
+inline int uCmp(const Bits<N>& A,const Bits<N>& B){
+    for(int k=(N+7)/8-1;k>=0;--k){
+        const SliceCmp& e = kSlice8.cmp[busByte(B,k)][busByte(A,k)];
+        if(!e.eq) return e.lt ? -1 : 1;
+    }
+    return 0;
+}
+
+// ---------------- ALU (ADD/SUB) with flags ----------------
+struct ALUFlags{ int N,Z,C,V; };
+struct ALUResult{ Bits<32> result; ALUFlags flags; };
+
+inline void ALU(const Bits<32> &a,const Bits<32> &b,bool subtract,ALUResult &out){
+    Bits<32> opB;
+    if(subtract) negateTwos<ALU_ADDER>(b,opB); else opB=b;
+    int carryOut=0; Bits<32> sum; ALU_ADDER::add(a,opB,sum,carryOut);
+    int sa=a[0], sb=b[0], sr=sum[0];
+    int overflow = (!subtract)? ((sa==sb) && (sr!=sa)) : ((sa!=sb) && (sr!=sa));
+    int zero=isZeroBits(sum);
+    out.result = sum;
+    out.flags = ALUFlags{ sr, zero, carryOut, overflow };
+}
+
+// ---------------- Shifts (SLL/SRL/SRA) on the barrel shifter ----------------
+// the shift amount is the low 5 wires of b, as in RV32
+inline void shiftUnit(const Bits<32>& a, const Bits<32>& b, ShiftKind kind, Bits<32>& out){
+    Bits<5> shamt; takeBits(b,0,shamt);
+    barrelShift(a,shamt,kind,out);
+}
+inline void sll(const Bits<32>& a, const Bits<32>& b, Bits<32>& out){ shiftUnit(a,b,ShiftKind::Left,out); }
+inline void srl(const Bits<32>& a, const Bits<32>& b, Bits<32>& out){ shiftUnit(a,b,ShiftKind::Logical,out); }
+inline void sra(const Bits<32>& a, const Bits<32>& b, Bits<32>& out){ shiftUnit(a,b,ShiftKind::Arithmetic,out); }
+
+// ---------------- MUL family (shift-add) ----------------
+struct MulOut{ Bits<32> low32; Bits<32> high32; int overflow; };
+
+// Unsigned 32x32 -> 64 via classic shift-add; with Trace every step is recorded into ring
+template <bool Trace>
+inline void shiftAddSteps(const Bits<32>& ua, const Bits<32>& ub, Bits<64>& acc, TraceRing* ring){
+    acc = zeros<64>();                   // 64-bit accumulator/product
+    Bits<64> multiplicand; zeroExtend(ua,multiplicand);
+    Bits<32> multiplier = ub;            // 32-bit
+    if constexpr (Trace) ring->begin(T_MUL_SHIFTADD, traceWord(ua), traceWord(ub));
+
+    for(int step=0; step<32; ++step){
+        int lsb = multiplier[31];
+        if(lsb){ int c=0; MUL_ADDER::add(acc, multiplicand, acc, c); /* carry beyond 64 ignored */ }
+        shiftLeft1(multiplicand, multiplicand);
+        shiftRight1Logical(multiplier, multiplier);
+        if constexpr (Trace) ring->step(step, traceWord(acc), traceWord(multiplicand), (uint32_t)traceWord(multiplier), lsb);
+    }
+}
+
+inline void mulUnsigned32x32(const Bits<32>& ua, const Bits<32>& ub, Bits<64>& acc, bool trace){
+    if(TraceRing* ring = traceTarget(trace)) shiftAddSteps<true>(ua,ub,acc,ring);
+    else shiftAddSteps<false>(ua,ub,acc,nullptr);
+}
+
+// split a 64-bit product into its high and low words
+inline void splitHiLo(const Bits<64>& prod, Bits<32>& hi, Bits<32>& lo){
+    takeBits(prod,32,hi);
+    takeBits(prod,0,lo);
+}
+
+// Overflow visibility: true 64-bit product fits in signed 32-bit?
+inline int mulOverflowFlag(const Bits<64>& prod64){
+    Bits<32> low32; takeBits(prod64,0,low32);
+    Bits<64> se64; signExtendTo(low32,se64);
+    return sameBits(se64,prod64)?0:1;
+}
+
+// ---- MUL engines: 32x32 -> 64 with each operand signed or unsigned ----
+// Shift-add on magnitudes, sign fixed up afterwards (the original MUL path)
+struct ShiftAddMul {
+    static const char* name() { return "shift-add"; }
+    static MulShape shape() {
+        AdderCost add = MUL_ADDER::cost<64>();
+        return { 32, 0, 32, 0, 0, add };   // 32 serial accumulate steps, each a full 64-bit add
+    }
+    static void multiply(const Bits<32>& a, int aSigned, const Bits<32>& b, int bSigned, Bits<64>& prod, bool trace){
+        Bits<32> aa, bb;
+        if(aSigned) absSigned<MUL_ADDER>(a,aa); else aa=a;
+        if(bSigned) absSigned<MUL_ADDER>(b,bb); else bb=b;
+        int neg = (aSigned & signBit(a)) ^ (bSigned & signBit(b));
+        mulUnsigned32x32(aa,bb,prod,trace);
+        if(neg && !isZeroBits(prod)) negateTwos<MUL_ADDER>(prod,prod);
+    }
+};
+
+// Booth recoding + carry-save tree, signs handled in the recoding (multipliers.h).
+// The final add is Kogge-Stone: the two rows out of the tree carry across most of the
+// word, which is the worst case for the ripple settle loop.
+using Booth4Wallace = BoothMul<4, WallaceTree, KoggeStone>;
+using Booth4Dadda   = BoothMul<4, DaddaTree,   KoggeStone>;
+using Booth8Wallace = BoothMul<8, WallaceTree, KoggeStone>;
+using Booth8Dadda   = BoothMul<8, DaddaTree,   KoggeStone>;
+
+inline void mul_ss(const Bits<32>& a, const Bits<32>& b, MulOut& out, bool trace){
+    Bits<64> prod; MUL_ENGINE::multiply(a,1,b,1,prod,trace);
+    splitHiLo(prod,out.high32,out.low32);
+    out.overflow = mulOverflowFlag(prod);
+}
+
+inline void mul_uu(const Bits<32>& a, const Bits<32>& b, MulOut& out, bool trace){
+    Bits<64> prod; MUL_ENGINE::multiply(a,0,b,0,prod,trace);
+    splitHiLo(prod,out.high32,out.low32);
+    out.overflow = 0;
+}
+
+inline void mul_su(const Bits<32>& a, const Bits<32>& b, MulOut& out, bool trace){
+    Bits<64> prod; MUL_ENGINE::multiply(a,1,b,0,prod,trace);
+    splitHiLo(prod,out.high32,out.low32);
+    out.overflow = 0;
+}
+
+// ---------------- DIV/REM family ----------------
+struct DivOut{ Bits<32> q; Bits<32> r; int overflow; };
+struct DivPair{ Bits<32> q; Bits<32> r; int overflow; };
+
+// A - B: returns R and noBorrow flag (1 => no borrow => A>=B)
+template <class Adder = RippleCarry, int N>
+inline void uSub(const Bits<N>& A, const Bits<N>& B, Bits<N>& R, int& noBorrow){ Bits<N> Bn; negateTwos<Adder>(B,Bn); Adder::add(A,Bn,R,noBorrow); }
+
+// ---- DIV engines: unsigned 32/32 for a nonzero divisor, returning the steps run ----
+// Restoring: 32 steps, each a trial subtract that is kept or dropped (the original DIV path)
+struct RestoringDiv {
+    static const char* name() { return "restoring"; }
+    template <bool Trace>
+    static void steps(const Bits<32>& dividend, const Bits<32>& divisor, Bits<32>& q, Bits<32>& r, TraceRing* ring){
+        Bits<32> R, Q, RminusD;
+        Bits<32> negD; negateTwos<DIV_ADDER>(divisor,negD); // -divisor is the same every step, so uSub's negate is hoisted
+        if constexpr (Trace) ring->begin(T_DIV_RESTORING, traceWord(dividend), traceWord(divisor));
+        for(int i=0;i<32;++i){
+            // shift-in next dividend bit (MSB-first)
+            int bit_in = dividend[i];
+            shiftLeft1(R,R); R.set(31,bit_in);
+            int noBorrow=0; DIV_ADDER::add(R, negD, RminusD, noBorrow); // R - divisor
+            int qbit = noBorrow ? 1 : 0; // if R>=divisor then set qbit and keep subtraction
+            if(qbit) R = RminusD; // else restore (do nothing)
+            shiftLeft1(Q,Q); Q.set(31,qbit);
+            if constexpr (Trace) ring->step(i, traceWord(R), 0, (uint32_t)traceWord(Q), qbit);
+        }
+        q = Q; r = R;
+    }
+    static int divide(const Bits<32>& dividend, const Bits<32>& divisor, Bits<32>& q, Bits<32>& r, bool trace){
+        if(TraceRing* ring = traceTarget(trace)) steps<true>(dividend,divisor,q,r,ring);
+        else steps<false>(dividend,divisor,q,r,nullptr);
+        return 32;
+    }
+};
+
+// Non-restoring and SRT radix-4 with early termination (dividers.h). SRT's one
+// carry-propagate add at the end resolves a carry-save remainder, so it is Kogge-Stone.
+using NonRestoringDivider = NonRestoringDiv<DIV_ADDER>;
+using Srt4Divider         = Srt4Div<KoggeStone>;
+
+// RISC-V DIVU/REMU: x / 0 = all ones, x % 0 = x
+template <class Engine>
+inline void divuWith(const Bits<32>& dividend, const Bits<32>& divisor, DivOut& out, bool trace){
+    if(isZeroBits(divisor)){
+        out.q = ones<32>(); // 0xFFFFFFFF
+        out.r = dividend; out.overflow = 0;
+        return;
+    }
+    Engine::divide(dividend, divisor, out.q, out.r, trace);
+    out.overflow = 0; // overflow not used for unsigned
+}
+
+inline void divu(const Bits<32>& dividend, const Bits<32>& divisor, DivOut& out, bool trace){ divuWith<DIV_ENGINE>(dividend,divisor,out,trace); }
+inline void divu_restoring(const Bits<32>& dividend, const Bits<32>& divisor, DivOut& out, bool trace){ divuWith<RestoringDiv>(dividend,divisor,out,trace); }
+
+// RISC-V DIV/REM: x / 0 = -1, x % 0 = x, INT_MIN / -1 = INT_MIN rem 0 (flagged)
+template <class Engine>
+inline void divSignedWith(const Bits<32>& A, const Bits<32>& B, DivPair& out, bool trace){
+    if(isZeroBits(B)){
+        out.q = ones<32>(); // -1
+        out.r = A; out.overflow = 0;
+        return;
+    }
+    // INT_MIN / -1 edge
+    Bits<32> intMinBits; intMinBits.set(0,1);
+    if(sameBits(A,intMinBits) && sameBits(B,ones<32>())){ out.q = intMinBits; out.r = zeros<32>(); out.overflow = 1; return; }
+
+    int sA=signBit(A), sB=signBit(B);
+    Bits<32> ua, ub; absSigned<DIV_ADDER>(A,ua); absSigned<DIV_ADDER>(B,ub);
+    DivOut d; divuWith<Engine>(ua, ub, d, trace);
+    out.q = d.q; out.r = d.r; out.overflow = 0;
+    if(sA ^ sB) negateTwos<DIV_ADDER>(out.q,out.q);   // quotient truncates toward zero
+    if(sA)      negateTwos<DIV_ADDER>(out.r,out.r);   // remainder sign follows dividend
+}
+
+inline void div_signed(const Bits<32>& A, const Bits<32>& B, DivPair& out, bool trace){ divSignedWith<DIV_ENGINE>(A,B,out,trace); }
+
+// ============================= Section 2: Test/Display Helpers (OK to use shifts & host ints) =============================
+
+// dynamic hex printer for any width
+template <int N>
+string bitsToHexN(const Bits<N>& b){
+    static const string tab="0123456789ABCDEF";
+    int nibbles = (N+3)/4;
+    string h="0x";
+    for(int i=nibbles-1;i>=0;--i){ int v=0; for(int j=3;j>=0;--j){ int p=i*4+j; v=(v<<1)|(p<N?b.get(p):0); } h += tab[v]; }
+    return h;
+}
+
+// 32-bit specific wrappers
+inline string bitsToHex32(const Bits<32>& b){ return bitsToHexN(b); }
+inline string bitsToHex64(const Bits<64>& b){ return bitsToHexN(b); }
+
+// grouped binary (underscore every 8 bits)
+template <int N>
+string bitsToBinStr(const Bits<N>& b){ string s=""; for(int i=0;i<N;++i){ s += (b[i]?'1':'0'); if((i%8)==7 && i!=N-1) s+="_"; } return s; }
+
+// int<->bits (TEST ONLY); values wider than 64 bits are sign-extended
+template <int N=32>
+Bits<N> intToBits(long long value){
+    Bits<N> bits;
+    for(int j=0;j<Bits<N>::W;++j) bits.w[j] = j==0 ? (uint64_t)value : (value<0 ? ~(uint64_t)0 : 0);
+    trimTop(bits);
+    return bits;
+}
+
+template <int N>
+long long bitsToInt(const Bits<N>& b){
+    unsigned long long v=b.w[0];
+    if(N<64 && b[0]) v -= (1ULL<<(N%64));
+    return (long long)v;
+}
+
+// host float <-> binary32 bit pattern (TEST ONLY)
+inline Bits<32> floatToBits(float f){ uint32_t u; memcpy(&u,&f,4); return intToBits((long long)u); }
+inline float bitsToFloat(const Bits<32>& b){ uint32_t u=(uint32_t)b.w[0]; float f; memcpy(&f,&u,4); return f; }
+
+// ADD/SUB pretty trace
+inline void printALUTrace(const string& op,const Bits<32>&a,const Bits<32>&b,const Bits<32>&r,const ALUFlags&f){
+    if(op=="ADD"){
+        cout << "\nBinary: A + B = " << bitsToBinStr(a) << " + " << bitsToBinStr(b) << " = " << bitsToBinStr(r) << "\n";
+        cout << "Hex:    A + B = " << bitsToHex32(a) << " + " << bitsToHex32(b) << " = " << bitsToHex32(r) << "\n";
+    }else{
+        cout << "\nBinary: A - B = " << bitsToBinStr(a) << " - " << bitsToBinStr(b) << " = " << bitsToBinStr(r) << "\n";
+        cout << "Hex:    A - B = " << bitsToHex32(a) << " - " << bitsToHex32(b) << " = " << bitsToHex32(r) << "\n";
+    }
+    cout << "Flags: N="<<f.N<<" Z="<<f.Z<<" C="<<f.C<<" V="<<f.V<<"\n";
+}
+
+// MUL/DIV pretty outputs
+inline void printMulResult(const Bits<32>&a,const Bits<32>&b,const MulOut& mo,const string& tag){
+    cout << "\n"<<tag<<": "<<bitsToHex32(a)<<" * "<<bitsToHex32(b)
+         << " -> low="<<bitsToHex32(mo.low32)
+         << " high="<<bitsToHex32(mo.high32)
+         << " overflow="<<mo.overflow <<"\n";
+}
+
+inline void printDivResultSigned(const Bits<32>&a,const Bits<32>&b,const DivPair& d){
+    long long qVal = bitsToInt(d.q);
+    long long rVal = bitsToInt(d.r);
+    cout << "\nDIV " << bitsToInt(a) << " / " << bitsToInt(b)
+         << " -> q = " << qVal << " (" << bitsToHex32(d.q) << ")"
+         << "; r = " << rVal << " (" << bitsToHex32(d.r) << ")"
+         << "; overflow=" << d.overflow << "\n";
+}
+
+inline void printDivResultUnsigned(const Bits<32>&a,const Bits<32>&b,const DivOut& d){
+    unsigned long long qVal = bitsToInt(d.q);
+    unsigned long long rVal = bitsToInt(d.r);
+    cout << "DIVU " << bitsToInt(a) << " / " << bitsToInt(b)
+         << " -> q = " << qVal << " (" << bitsToHex32(d.q) << ")"
+         << "; r = " << rVal << " (" << bitsToHex32(d.r) << ")"
+         << "; overflow=0\n";
+}
+
+
+// ============================= Section 4: IEEE-754 Float32 Representation =============================
+// Representation: 1 sign bit, 8 exponent bits (bias = 127), 23 fraction bits (implicit 1 for normals)
+// All arithmetic on bits, no host float operations inside encoding logic
+// -------------------------------------------------------------------------------------
+
+struct Float32 {
+    int sign;          // 0 = positive, 1 = negative
+    Bits<8> exponent;  // 8 bits, unsigned with bias 127
+    Bits<23> fraction; // 23 bits (mantissa without the leading 1)
+};
+
+// ---- exponent constants ----
+inline Bits<8> bias127_8(){ Bits<8> b = ones<8>(); b.set(0,0); return b; } // 0x7F
+inline Bits<8> one8(){ Bits<8> b; b.set(7,1); return b; }                  // 0x01
+
+// ---- Decode a 32-bit float bit-vector into sign, exponent, and fraction ----
+inline Float32 decodeFloat32(const Bits<32>& bits) {
+    Float32 f;
+    f.sign = bits[0];
+    takeBits(bits, 23, f.exponent);   // bits[1..8]
+    takeBits(bits, 0, f.fraction);    // bits[9..31]
+    return f;
+}
+
+// ---- Encode a Float32 struct back into a 32-bit bit-vector ----
+inline void encodeFloat32(const Float32& f, Bits<32>& bits) {
+    bits = zeros<32>();
+    bits.set(0, f.sign);
+    placeBits(f.exponent, 23, bits);
+    placeBits(f.fraction, 0, bits);
+}
+
+
+// ============================= Float32 Rounding & Specials =============================
+// Results are IEEE-754 binary32 for every input class (zero, subnormal, normal, Inf, NaN)
+// under the five RISC-V rounding modes. A NaN result is always the canonical quiet NaN
+// 0x7FC00000, as on RISC-V. Exponents travel on a 10-bit signed bus through FLOAT_ADDER;
+// alignment and normalization shift on the barrel shifter (shifters.h), with the amount
+// on wires: an exponent difference, or the tree leading-zero count.
+
+// RISC-V frm encoding order
+enum class RoundingMode { RNE = 0, RTZ = 1, RDN = 2, RUP = 3, RMM = 4 };
+
+struct FloatClass { int zero, subnormal, inf, nan; };
+
+inline FloatClass classifyFloat32(const Float32& f) {
+    int eZero = isZeroBits(f.exponent), eOnes = sameBits(f.exponent, ones<8>()), fZero = isZeroBits(f.fraction);
+    return { eZero & fZero, eZero & !fZero, eOnes & fZero, eOnes & !fZero };
+}
+
+inline void canonicalNaN32(Bits<32>& out) { out = zeros<32>(); placeBits(ones<9>(), 22, out); }
+inline void signedInf32(int sign, Bits<32>& out) { out = zeros<32>(); placeBits(ones<8>(), 23, out); out.put(31, sign); }
+inline void signedZero32(int sign, Bits<32>& out) { out = zeros<32>(); out.put(31, sign); }
+
+// biased exponent on the 10-bit bus (subnormals use exponent 1) and the 24-bit significand
+inline void unpackSig(const Float32& f, Bits<10>& e, Bits<24>& m) {
+    int sub = isZeroBits(f.exponent);
+    resizeBits(f.exponent, e); if (sub) e.put(0, 1);
+    resizeBits(f.fraction, m); m.put(23, !sub);
+}
+
+// y = x routed a fixed k wires toward the LSB; anything routed off the bottom is ORed into wire 0 (sticky)
+template <int N>
+inline void shiftRightJam(const Bits<N>& x, int k, Bits<N>& y) {
+    if (k <= 0) { y = x; return; }
+    Bits<N> lost = x;
+    if (k < N) wireShiftUp(x, N - k, lost);
+    int sticky = !isZeroBits(lost);
+    wireShiftDown(x, k, y);
+    if (sticky) y.put(0, 1);
+}
+
+// overflow: Inf, or the largest finite value when the mode rounds toward zero for this sign
+inline void overflow32(int sign, RoundingMode rm, Bits<32>& out) {
+    int toInf = rm == RoundingMode::RNE || rm == RoundingMode::RMM ||
+                (rm == RoundingMode::RUP && !sign) || (rm == RoundingMode::RDN && sign);
+    if (toInf) { signedInf32(sign, out); return; }
+    Bits<31> maxFinite = ones<31>(); maxFinite.put(23, 0);   // 0x7F7FFFFF
+    resizeBits(maxFinite, out); out.put(31, sign);
+}
+
+// Round and pack. exp = biased exponent of wire 26 of sig; wires 2,1,0 of sig are guard,
+// round and sticky. Either wire 26 is 1 (normal), or exp is 1 (subnormal range, no hidden
+// bit), or exp <= 0 and sig is shifted down into the subnormal range here.
+inline void roundPack32(int sign, Bits<10> exp, Bits<27> sig, RoundingMode rm, Bits<32>& out) {
+    int c = 0;
+    if (signBit(exp) || isZeroBits(exp)) {
+        Bits<10> k; negateTwos<FLOAT_ADDER>(exp, k);
+        FLOAT_ADDER::add(k, intToBits<10>(1), k, c);         // 1 - exp
+        barrelShiftRightJam(sig, k, sig);
+        exp = intToBits<10>(1);                              // packed field becomes 0
+    } else if (exp.get(8)) {                                 // exp >= 256
+        overflow32(sign, rm, out); return;
+    }
+    if (sameBits(exp, intToBits<10>(255))) { overflow32(sign, rm, out); return; }
+
+    int g = sig.get(2), r = sig.get(1), s = sig.get(0), lsb = sig.get(3), inexact = g | r | s;
+    int inc = rm == RoundingMode::RNE ? g & (r | s | lsb)
+            : rm == RoundingMode::RDN ? sign & inexact
+            : rm == RoundingMode::RUP ? (!sign) & inexact
+            : rm == RoundingMode::RMM ? g : 0;
+
+    // {exp - 1, 0...} + {hidden, fraction}: the hidden bit lands in the exponent field,
+    // so a subnormal that rounds up to 2^-126 or a carry out of the fraction needs no fix-up
+    Bits<10> em1; FLOAT_ADDER::add(exp, intToBits<10>(-1), em1, c);
+    Bits<8> field; takeBits(em1, 0, field);
+    Bits<31> packed, s24, one;
+    placeBits(field, 23, packed);
+    Bits<24> sig24; takeBits(sig, 3, sig24); resizeBits(sig24, s24);
+    FLOAT_ADDER::add(packed, s24, packed, c);
+    one.put(0, inc);
+    FLOAT_ADDER::add(packed, one, packed, c);
+    Bits<8> outExp; takeBits(packed, 23, outExp);
+    if (sameBits(outExp, ones<8>())) { overflow32(sign, rm, out); return; }
+    resizeBits(packed, out); out.put(31, sign);
+}
+
+
+// ============================= Float32 Addition/Subtraction =============================
+// Align the smaller operand with guard/round/sticky wires, add or subtract the
+// significands, normalize by the leading-zero count (stopping at the subnormal
+// exponent), then round. Exact cancellation gives +0 (-0 when rounding down).
+
+inline void floatAddSub(const Bits<32>& a, const Bits<32>& b, bool subtract, Bits<32>& out,
+                        RoundingMode rm = RoundingMode::RNE) {
+    Float32 A = decodeFloat32(a);
+    Float32 B = decodeFloat32(b);
+    B.sign ^= subtract;
+    FloatClass ca = classifyFloat32(A), cb = classifyFloat32(B);
+    if (ca.nan || cb.nan) { canonicalNaN32(out); return; }
+    if (ca.inf || cb.inf) {
+        if (ca.inf && cb.inf && A.sign != B.sign) { canonicalNaN32(out); return; }   // Inf - Inf
+        signedInf32(ca.inf ? A.sign : B.sign, out); return;
+    }
+
+    // order by magnitude: X is the larger, its exponent leads
+    Bits<31> magA, magB; takeBits(a, 0, magA); takeBits(b, 0, magB);
+    if (uCmp(magA, magB) < 0) swap(A, B);
+
+    Bits<10> eX, eY; Bits<24> sX, sY;
+    unpackSig(A, eX, sX); unpackSig(B, eY, sY);
+    Bits<28> mX, mY;                                     // carry, hidden, 23 fraction, G R S
+    resizeBits(sX, mX); wireShiftUp(mX, 3, mX);
+    resizeBits(sY, mY); wireShiftUp(mY, 3, mY);
+
+    int c = 0;
+    Bits<10> negEY, diff; negateTwos<FLOAT_ADDER>(eY, negEY);
+    FLOAT_ADDER::add(eX, negEY, diff, c);                // >= 0
+    barrelShiftRightJam(mY, diff, mY);
+
+    Bits<28> sum;
+    int effSub = A.sign ^ B.sign;
+    if (effSub) { Bits<28> negY; negateTwos<FLOAT_ADDER>(mY, negY); FLOAT_ADDER::add(mX, negY, sum, c); }
+    else FLOAT_ADDER::add(mX, mY, sum, c);
+
+    if (isZeroBits(sum)) { signedZero32(effSub ? rm == RoundingMode::RDN : A.sign, out); return; }
+
+    Bits<10> exp = eX;
+    Bits<27> sig;
+    if (sum.get(27)) {                                   // carry out: one wire down, exponent + 1
+        shiftRightJam(sum, 1, sum);
+        FLOAT_ADDER::add(exp, intToBits<10>(1), exp, c);
+        takeBits(sum, 0, sig);
+    } else {
+        takeBits(sum, 0, sig);
+        Bits<10> room; FLOAT_ADDER::add(exp, intToBits<10>(-1), room, c);   // shifts left before subnormal
+        Bits<10> lz, sh, negSh; resizeBits(lzcTree(sig), lz);
+        sh = uCmp(lz, room) < 0 ? lz : room;
+        barrelShift(sig, sh, ShiftKind::Left, sig);
+        negateTwos<FLOAT_ADDER>(sh, negSh);
+        FLOAT_ADDER::add(exp, negSh, exp, c);
+    }
+    roundPack32(A.sign, exp, sig, rm, out);
+}
+
+
+// ============================= Float32 Multiplication =============================
+// 1. Specials: NaN in -> NaN; Inf * 0 -> NaN; Inf or 0 operands give Inf or 0
+// 2. Result sign = XOR(signA, signB); exponent = eA + eB - 127 on the 10-bit bus
+// 3. 24 x 24 significand product on the MUL_ENGINE (48 bits, leading 1 at wire 47 or 46,
+//    or lower when an operand is subnormal)
+// 4. Normalize by the leading-zero count, keep 27 wires with sticky, round and pack
+
+inline void floatMultiply(const Bits<32>& a, const Bits<32>& b, Bits<32>& out,
+                          RoundingMode rm = RoundingMode::RNE) {
+    Float32 A = decodeFloat32(a);
+    Float32 B = decodeFloat32(b);
+    int resultSign = A.sign ^ B.sign;
+    FloatClass ca = classifyFloat32(A), cb = classifyFloat32(B);
+    if (ca.nan || cb.nan || (ca.inf && cb.zero) || (ca.zero && cb.inf)) { canonicalNaN32(out); return; }
+    if (ca.inf || cb.inf) { signedInf32(resultSign, out); return; }
+    if (ca.zero || cb.zero) { signedZero32(resultSign, out); return; }
+
+    Bits<10> eA, eB, exp; Bits<24> mA, mB;
+    unpackSig(A, eA, mA); unpackSig(B, eB, mB);
+    int c = 0;
+    FLOAT_ADDER::add(eA, eB, exp, c);
+    FLOAT_ADDER::add(exp, intToBits<10>(-126), exp, c);  // - 127, + 1 for a leading 1 at wire 47
+
+    Bits<32> mA32, mB32; zeroExtend(mA, mA32); zeroExtend(mB, mB32);
+    Bits<64> prod; MUL_ENGINE::multiply(mA32, 0, mB32, 0, prod, false);
+
+    Bits<48> p48; resizeBits(prod, p48);
+    Bits<6> lz = lzcTree(p48);                           // nonzero operands: lz <= 46
+    barrelShift(p48, lz, ShiftKind::Left, p48);
+    Bits<10> negLz; resizeBits(lz, negLz); negateTwos<FLOAT_ADDER>(negLz, negLz);
+    FLOAT_ADDER::add(exp, negLz, exp, c);
+    Bits<48> low; wireShiftUp(p48, 27, low);             // the 21 wires below the kept 27
+    Bits<27> sig; takeBits(p48, 21, sig);
+    if (!isZeroBits(low)) sig.put(0, 1);
+    roundPack32(resultSign, exp, sig, rm, out);
+}
+
+
+inline void printFloat32(const Bits<32>& bits) {
+    Float32 f = decodeFloat32(bits);
+    cout << "Float32 bits: " << bitsToHex32(bits)
+         << " (sign=" << f.sign
+         << ", exp=" << bitsToHexN(f.exponent)
+         << ", frac=" << bitsToHexN(f.fraction) << ")" << endl;
+}
@@ -0,0 +1,129 @@
+// shift_verify.cpp - barrel shifter and tree leading-zero counter against a wire-by-wire reference
+// Build: g++ -O2 -std=c++17 shift_verify.cpp -o shift_verify
+// Usage: shift_verify [--random N] [--seed S]
+//
+// Runs N vectors (default 200000) at every width the float datapaths shift: 24 and 48 (the
+// binary32 significand and product), 27 (the binary32 rounding significand) and F+4 of each
+// format in float_formats.h. A vector is uniform wires, uniform wires routed down a random
+// distance (leading-zero runs), all zeros or all ones. Each one goes through lzcTree and
+// through barrelShift in all three kinds, with the amount on a 10-wire bus (an exponent bus:
+// 0..1023, so the out-of-range stage is hit) and on the LZC's own bus width.
+// The reference reads and writes single wires with get/put (TEST side: host ints fine);
+// vector i depends only on (seed, width, i).
+// Exit code: 0 all passed, 1 mismatch (first one reported), 2 usage error.
+#include "float_formats.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// ============================== Reference ==============================
+template <int N>
+static int refLeadingZeros(const Bits<N>& x){
+    for(int p=N-1;p>=0;--p) if(x.get(p)) return N-1-p;
+    return N;
+}
+
+// y = x shifted by k; returns the sticky wire (a 1 routed off the bottom by a right shift)
+template <int N>
+static int refShift(const Bits<N>& x, int k, ShiftKind kind, Bits<N>& y){
+    int sticky = 0, sign = kind == ShiftKind::Arithmetic ? x.get(N-1) : 0;
+    y = Bits<N>{};
+    for(int p=0;p<N;++p){
+        if(kind == ShiftKind::Left) y.put(p, p-k >= 0 ? x.get(p-k) : 0);
+        else y.put(p, p+k < N ? x.get(p+k) : sign);
+    }
+    if(kind != ShiftKind::Left) for(int p=0;p<N && p<k;++p) sticky |= x.get(p);
+    return sticky;
+}
+
+// ============================== Vectors ==============================
+static uint64_t splitmix64(uint64_t x){
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+template <int N>
+static void vectorAt(uint64_t seed, uint64_t i, Bits<N>& x, uint64_t& r){
+    r = splitmix64(seed ^ splitmix64(i * 1024 + N));
+    for(int w=0;w<Bits<N>::W;++w) x.w[w] = splitmix64(r + w);
+    trimTop(x);
+    switch(r % 16){
+    case 0:  x = Bits<N>{}; break;
+    case 1:  x = ones<N>(); break;
+    default: if(r % 16 < 10) wireShiftDown(x, (int)((r >> 8) % N), x); break;
+    }
+}
+
+static const char* const kKindName[3] = { "left", "logical", "arithmetic" };
+
+struct Mismatch { bool found = false; string what; };
+
+template <int N, int A>
+static bool checkShift(const Bits<N>& x, int k, ShiftKind kind, Mismatch& bad){
+    Bits<A> amount = intToBits<A>(k);
+    Bits<N> got, want;
+    int s = barrelShift(x, amount, kind, got), ws = refShift(x, k, kind, want);
+    if(sameBits(got, want) && (kind == ShiftKind::Left || s == ws)) return true;
+    bad.found = true;
+    bad.what = string("barrelShift ") + kKindName[(int)kind] + " amount " + to_string(k) + " on " + to_string(A) + " wires\n"
+             + "  x    = " + bitsToHexN(x) + "\n  want = " + bitsToHexN(want) + " sticky " + to_string(ws)
+             + "\n  got  = " + bitsToHexN(got) + " sticky " + to_string(s);
+    return false;
+}
+
+template <int N>
+static bool checkWidth(const char* usedBy, uint64_t n, uint64_t seed){
+    constexpr int B = lzcWidth<N>();
+    Mismatch bad;
+    uint64_t i = 0;
+    for(; i<n && !bad.found; ++i){
+        Bits<N> x; uint64_t r;
+        vectorAt(seed, i, x, r);
+        int lz = busIndex(lzcTree(x)), want = refLeadingZeros(x);
+        if(lz != want){
+            bad.found = true;
+            bad.what = "lzcTree\n  x    = " + bitsToHexN(x) + "\n  want = " + to_string(want) + "\n  got  = " + to_string(lz);
+            continue;
+        }
+        int wide = (int)((r >> 16) % 1024);                 // exponent bus: any value
+        int narrow = (int)((r >> 32) % (N + 1));             // an LZC-sized amount, 0..N
+        for(int kind=0;kind<3;++kind){
+            ShiftKind sk = (ShiftKind)kind;
+            if(!checkShift<N, 10>(x, wide, sk, bad) || !checkShift<N, 10>(x, wide % (N + 1), sk, bad)
+               || !checkShift<N, B>(x, narrow, sk, bad)) break;
+        }
+    }
+    printf("%5d  %-30s %10llu  %s\n", N, usedBy, (unsigned long long)i, bad.found ? "MISMATCH" : "ok");
+    if(bad.found) printf("  vector %llu (seed %llu): %s\n", (unsigned long long)(i - 1), (unsigned long long)seed, bad.what.c_str());
+    return !bad.found;
+}
+
+static bool parseU64(const char* s, uint64_t& v){ char* e; v = strtoull(s, &e, 0); return *s && !*e; }
+
+static int usage(){
+    fprintf(stderr, "usage: shift_verify [--random N] [--seed S]\n");
+    return 2;
+}
+
+int main(int argc, char** argv){
+    uint64_t n = 200000, seed = 1;
+    for(int i=1;i<argc;++i){
+        string arg = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(arg == "--random" && v && parseU64(v, n)) ++i;
+        else if(arg == "--seed" && v && parseU64(v, seed)) ++i;
+        else return usage();
+    }
+    printf("shift_verify: %llu vectors per width, seed %llu\n\n", (unsigned long long)n, (unsigned long long)seed);
+    printf("%5s  %-30s %10s  %s\n", "width", "used by", "vectors", "result");
+    bool ok = checkWidth<24>("binary32 significand", n, seed);
+    ok = checkWidth<27>("binary32 rounding significand", n, seed) && ok;
+    ok = checkWidth<48>("binary32 product", n, seed) && ok;
+    ok = checkWidth<Binary16::kFrac + 4>("binary16 F+4", n, seed) && ok;
+    ok = checkWidth<BFloat16::kFrac + 4>("bfloat16 F+4", n, seed) && ok;
+    ok = checkWidth<Binary64::kFrac + 4>("binary64 F+4", n, seed) && ok;
+    return ok ? 0 : 1;
+}
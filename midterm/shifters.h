@@ -0,0 +1,132 @@
+// shifters.h - logarithmic barrel shifter and tree leading-zero counter
+// One shifter serves the integer shifts (SLL/SRL/SRA in numeric_ops.h) and the float units'
+// alignment and normalization: the shift amount arrives on wires (an exponent difference, a
+// leading-zero count) and passes log2 N multiplexer stages, so depth no longer depends on it.
+#pragma once
+
+#include "bits.h"
+
+#include <cstdint>
+#include <utility>
+
+// ============================= Section 1d: Shifters (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---- word-wide gate used below ----
+template <int N>
+inline void orWires(Bits<N>& x, const Bits<N>& y) { for (int w = 0; w < Bits<N>::W; ++w) x.w[w] |= y.w[w]; }
+
+// ---------------- Barrel shifter ----------------
+enum class ShiftKind { Left, Logical, Arithmetic };
+
+// stages that route by less than N wires: amount wires 0 .. barrelStages<N,A>()-1
+template <int N, int A>
+constexpr int barrelStages() { int k = 0; while (k < A && (1 << k) < N) ++k; return k; }
+
+// Stage J is a 2:1 multiplexer per wire: amount wire J selects the vector routed 2^J wires.
+// A right stage also collects the wires it routes off the bottom (sticky) and fills the top.
+template <int J, int N, int A>
+inline void barrelStage(Bits<N>& v, const Bits<A>& amount, ShiftKind kind, uint64_t fill, uint64_t& sticky) {
+    constexpr int s = 1 << J, W = Bits<N>::W;
+    const uint64_t sel = fanOut(amount.get(J));
+    Bits<N> t, lost, top;
+    if (kind == ShiftKind::Left) wireShiftUp(v, s, t);
+    else {
+        wireShiftUp(v, N - s, lost);                     // the s wires leaving at the bottom
+        wireShiftUp(ones<N>(), N - s, top);         // the s wires entering at the top
+        wireShiftDown(v, s, t);
+        for (int w = 0; w < W; ++w) { sticky |= lost.w[w] & sel; t.w[w] |= top.w[w] & fill; }
+    }
+    for (int w = 0; w < W; ++w) v.w[w] = (t.w[w] & sel) | (v.w[w] & ~sel);
+}
+
+template <int N, int A, int... J>
+inline void barrelStageChain(Bits<N>& v, const Bits<A>& amount, ShiftKind kind, uint64_t fill, uint64_t& sticky,
+                             std::integer_sequence<int, J...>) {
+    (barrelStage<J>(v, amount, kind, fill, sticky), ...);
+}
+
+// log2 N stages, laid out at compile time; the amount wires from log2 N up are ORed into one
+// last stage that routes everything out.
+// Returns the sticky wire of a right shift: 1 if any 1 was routed off the bottom.
+template <int N, int A>
+inline int barrelShift(const Bits<N>& x, const Bits<A>& amount, ShiftKind kind, Bits<N>& y) {
+    constexpr int K = barrelStages<N, A>(), W = Bits<N>::W;
+    const uint64_t fill = fanOut(kind == ShiftKind::Arithmetic && x.get(N - 1));
+    Bits<N> v = x;
+    uint64_t sticky = 0;
+    barrelStageChain(v, amount, kind, fill, sticky, std::make_integer_sequence<int, K>{});
+    int over = 0;
+    for (int j = K; j < A; ++j) over |= amount.get(j);
+    const uint64_t all = fanOut(over);
+    const Bits<N> high = ones<N>();
+    for (int w = 0; w < W; ++w) {
+        if (kind != ShiftKind::Left) sticky |= v.w[w] & all;
+        v.w[w] = (v.w[w] & ~all) | (high.w[w] & fill & all);
+    }
+    y = v;
+    return sticky != 0;
+}
+
+// logical right shift with the sticky wire ORed into wire 0 (float alignment)
+template <int N, int A>
+inline void barrelShiftRightJam(const Bits<N>& x, const Bits<A>& amount, Bits<N>& y) {
+    if (barrelShift(x, amount, ShiftKind::Logical, y)) y.put(0, 1);
+}
+
+// ---------------- Leading-zero counter ----------------
+// wires needed for a count of 0..N
+template <int N>
+constexpr int lzcWidth() { int b = 0; while ((1 << b) <= N) ++b; return b; }
+
+// encoder masks: mask j selects the wires p whose leading-zero count N-1-p has bit j set
+template <int N>
+struct LzcMasks {
+    static constexpr int B = lzcWidth<N>();
+    uint64_t m[B][Bits<N>::W];
+    constexpr LzcMasks() : m() {
+        for (int p = 0; p < N; ++p)
+            for (int j = 0; j < B; ++j)
+                if ((N - 1 - p) & (1 << j)) m[j][p / 64] |= kWire.m[p % 64];
+    }
+};
+template <int N>
+inline constexpr LzcMasks<N> kLzcMasks{};
+
+// prefix stage J: every wire ORs in the wire 2^J above it
+template <int J, int N>
+inline void lzcPrefixStage(Bits<N>& seen) {
+    Bits<N> t;
+    wireShiftDown(seen, 1 << J, t);
+    orWires(seen, t);
+}
+
+// encoder wire J: an OR tree over the leading-one positions whose count has bit J set
+template <int J, int N, int B>
+inline void lzcEncodeWire(const Bits<N>& lead, Bits<B>& out) {
+    uint64_t any = 0;
+    for (int w = 0; w < Bits<N>::W; ++w) any |= lead.w[w] & kLzcMasks<N>.m[J][w];
+    out.put(J, any != 0);
+}
+
+template <int N, int B, int... P, int... E>
+inline void lzcChains(Bits<N>& seen, Bits<N>& lead, Bits<B>& out, std::integer_sequence<int, P...>, std::integer_sequence<int, E...>) {
+    (lzcPrefixStage<P>(seen), ...);
+    Bits<N> t;
+    wireShiftDown(seen, 1, t);                           // one-hot: the leading one
+    for (int w = 0; w < Bits<N>::W; ++w) lead.w[w] = seen.w[w] & ~t.w[w];
+    (lzcEncodeWire<E>(lead, out), ...);
+}
+
+// Leading zeros of x as a bus of lzcWidth<N>() wires, in two trees: a parallel-prefix OR
+// (log2 N stages; wire p becomes the OR of every wire at or above p) whose edge marks the
+// leading one, then one OR tree per count wire over the positions that set it.
+// All-zero input gives N.
+template <int N>
+inline Bits<lzcWidth<N>()> lzcTree(const Bits<N>& x) {
+    constexpr int B = lzcWidth<N>();
+    Bits<N> seen = x, lead;
+    Bits<B> out;
+    lzcChains(seen, lead, out, std::make_integer_sequence<int, lzcWidth<N - 1>()>{}, std::make_integer_sequence<int, B>{});
+    if (!seen.get(0)) out.w[0] = (uint64_t)N;           // all zero: the constant N on the bus
+    return out;
+}
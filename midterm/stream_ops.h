@@ -0,0 +1,332 @@
+// stream_ops.h - streaming batch evaluation: records in, one result line per record out
+// Input: one record per line, "op A B [rm]"; blank lines (separators only) and lines starting
+// with '#' are skipped.
+//   integer ops: add sub mul mulh mulhsu mulhu div divu rem remu sll srl sra
+//   float ops:   fadd fsub fmul fdiv fsqrt (no B); optional rm = rne rtz rdn rup rmm
+//   operands: decimal (-15) or hex (0xFFFFFFF1); float operands may also be decimal values (2.5, -1e-3)
+// Output (same order): "op 0xAAAAAAAA 0xBBBBBBBB = 0xRRRRRRRR" plus nzcv=.... for add/sub,
+// ovf=. for mul/div/rem and the rounding mode for float ops; bad records give "error line N: ...".
+// Pipeline: a parser thread fills batches from large fread chunks, a worker pool runs the
+// units on whole batches, and the calling thread formats batches back in sequence and
+// writes in large chunks. Stages hand batches over bounded queues and a fixed pool of
+// batches is recycled, so memory stays constant whatever the input size.
+#pragma once
+
+#include "float_divsqrt.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================= Bounded queue =============================
+template <class T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : cap(capacity) {}
+    void push(T v) {
+        unique_lock<mutex> lk(m);
+        notFull.wait(lk, [&]{ return q.size() < cap; });
+        q.push_back(v);
+        notEmpty.notify_one();
+    }
+    // false once closed and drained
+    bool pop(T& v) {
+        unique_lock<mutex> lk(m);
+        notEmpty.wait(lk, [&]{ return !q.empty() || closed; });
+        if (q.empty()) return false;
+        v = q.front(); q.erase(q.begin());
+        notFull.notify_one();
+        return true;
+    }
+    void close() { lock_guard<mutex> lk(m); closed = true; notEmpty.notify_all(); }
+private:
+    size_t cap;
+    bool closed = false;
+    vector<T> q;   // at most a handful of batch pointers
+    mutex m;
+    condition_variable notFull, notEmpty;
+};
+
+// ============================= Records =============================
+enum StreamOp : uint8_t {
+    S_ADD, S_SUB, S_MUL, S_MULH, S_MULHSU, S_MULHU, S_DIV, S_DIVU, S_REM, S_REMU, S_SLL, S_SRL, S_SRA,
+    S_FADD, S_FSUB, S_FMUL, S_FDIV, S_FSQRT, S_OPS
+};
+static const char* const kStreamOpName[S_OPS] = {
+    "add", "sub", "mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu", "sll", "srl", "sra",
+    "fadd", "fsub", "fmul", "fdiv", "fsqrt"
+};
+static const char* const kRoundName[] = { "rne", "rtz", "rdn", "rup", "rmm" };
+
+enum StreamError : uint8_t { E_NONE, E_OP, E_OPERAND, E_MISSING, E_EXTRA, E_LONG };
+static const char* const kStreamErrorText[] = {
+    "", "unknown op", "bad operand", "missing operand", "unexpected field", "line too long"
+};
+
+struct StreamRecord {
+    uint64_t line;
+    uint32_t a, b, r;
+    uint8_t op, rm, err, flags;   // flags: nzcv (add/sub) or overflow (mul/div/rem)
+};
+
+constexpr size_t kStreamBatch = 8192;     // records per batch
+constexpr size_t kStreamChunk = 4 << 20;  // input read size
+constexpr size_t kStreamFlush = 1 << 20;  // output write size
+constexpr size_t kStreamLine = 256;       // longest accepted line
+
+struct StreamBatch {
+    uint64_t seq = 0;
+    size_t n = 0;
+    StreamRecord rec[kStreamBatch];
+};
+
+// ============================= Parse (TEST side: host arithmetic fine) =============================
+inline bool parseIntToken(const char* s, const char* e, uint32_t& v) {
+    bool neg = false;
+    if (s < e && (*s == '-' || *s == '+')) { neg = *s == '-'; ++s; }
+    if (s == e) return false;
+    uint64_t x = 0;
+    if (e - s > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        s += 2;
+        if (e - s > 8) return false;
+        for (; s < e; ++s) {
+            int d = *s >= '0' && *s <= '9' ? *s - '0' : *s >= 'a' && *s <= 'f' ? *s - 'a' + 10 : *s >= 'A' && *s <= 'F' ? *s - 'A' + 10 : -1;
+            if (d < 0) return false;
+            x = x * 16 + (uint64_t)d;
+        }
+    } else {
+        if (e - s > 10) return false;
+        for (; s < e; ++s) { if (*s < '0' || *s > '9') return false; x = x * 10 + (uint64_t)(*s - '0'); }
+    }
+    if (neg ? x > 0x80000000ull : x > 0xFFFFFFFFull) return false;
+    v = neg ? (uint32_t)(0 - x) : (uint32_t)x;
+    return true;
+}
+
+// float operands: hex is the bit pattern; anything else is read as a decimal value
+inline bool parseFloatToken(const char* s, const char* e, uint32_t& v) {
+    const char* h = s + (s < e && (*s == '-' || *s == '+'));
+    if (e - h > 2 && h[0] == '0' && (h[1] == 'x' || h[1] == 'X')) return parseIntToken(s, e, v);
+    char buf[64];
+    if (e - s >= (ptrdiff_t)sizeof buf) return false;
+    memcpy(buf, s, e - s); buf[e - s] = 0;
+    char* end;
+    float f = strtof(buf, &end);
+    if (end == buf || *end) return false;
+    memcpy(&v, &f, 4);
+    return true;
+}
+
+inline void parseRecord(const char* s, const char* e, StreamRecord& r) {
+    const char* tok[5]; const char* end[5];
+    int n = 0;
+    while (s < e) {
+        while (s < e && (*s == ' ' || *s == '\t' || *s == ',' || *s == '\r')) ++s;
+        if (s == e) break;
+        if (n == 5) { r.err = E_EXTRA; return; }
+        tok[n] = s;
+        while (s < e && *s != ' ' && *s != '\t' && *s != ',' && *s != '\r') ++s;
+        end[n++] = s;
+    }
+    if (n == 0) { r.err = E_OP; return; }   // the parser skips these; keep tok[0] defined anyway
+    r.op = S_OPS;
+    for (int k = 0; k < S_OPS; ++k)
+        if ((size_t)(end[0] - tok[0]) == strlen(kStreamOpName[k]) && !memcmp(tok[0], kStreamOpName[k], end[0] - tok[0])) r.op = (uint8_t)k;
+    if (r.op == S_OPS) { r.err = E_OP; return; }
+    bool isFloat = r.op >= S_FADD;
+    int operands = r.op == S_FSQRT ? 1 : 2;
+    if (n < 1 + operands) { r.err = E_MISSING; return; }
+    r.b = 0; r.rm = 0;
+    bool ok = isFloat ? parseFloatToken(tok[1], end[1], r.a) : parseIntToken(tok[1], end[1], r.a);
+    if (ok && operands == 2) ok = isFloat ? parseFloatToken(tok[2], end[2], r.b) : parseIntToken(tok[2], end[2], r.b);
+    if (!ok) { r.err = E_OPERAND; return; }
+    if (n > 1 + operands) {
+        int rm = -1;
+        for (int k = 0; k < 5; ++k)
+            if (end[1 + operands] - tok[1 + operands] == 3 && !memcmp(tok[1 + operands], kRoundName[k], 3)) rm = k;
+        if (!isFloat || rm < 0 || n > 2 + operands) { r.err = E_EXTRA; return; }
+        r.rm = (uint8_t)rm;
+    }
+    r.err = E_NONE;
+}
+
+// Reads lines from a FILE in large chunks and hands them out one at a time.
+class LineReader {
+public:
+    explicit LineReader(FILE* f) : in(f), buf(kStreamChunk + kStreamLine) {}
+    // false at end of input; `tooLong` lines are skipped up to their newline
+    bool next(const char*& s, const char*& e, bool& tooLong) {
+        tooLong = false;
+        for (;;) {
+            char* nl = pos < fill ? (char*)memchr(&buf[pos], '\n', fill - pos) : nullptr;
+            if (nl) {
+                s = &buf[pos]; e = nl; pos = nl - &buf[0] + 1;
+                if (skipping || e - s > (ptrdiff_t)kStreamLine) { skipping = false; tooLong = true; }
+                return true;
+            }
+            if (eof) {
+                if (pos == fill) return false;
+                s = &buf[pos]; e = &buf[fill]; pos = fill;
+                if (skipping || e - s > (ptrdiff_t)kStreamLine) { skipping = false; tooLong = true; }
+                return true;
+            }
+            size_t keep = fill - pos;                   // partial line: move it to the front
+            if (keep > kStreamLine) { skipping = true; keep = 0; }
+            memmove(&buf[0], &buf[pos], keep);
+            pos = 0; fill = keep;
+            size_t got = fread(&buf[fill], 1, buf.size() - fill, in);
+            fill += got;
+            if (got == 0) eof = true;
+        }
+    }
+private:
+    FILE* in;
+    vector<char> buf;
+    size_t pos = 0, fill = 0;
+    bool eof = false, skipping = false;
+};
+
+// ============================= Compute =============================
+inline void computeRecord(StreamRecord& r) {
+    if (r.err) return;
+    Bits<32> A = intToBits((long long)r.a), B = intToBits((long long)r.b), R;
+    RoundingMode rm = (RoundingMode)r.rm;
+    r.flags = 0;
+    switch (r.op) {
+    case S_ADD: case S_SUB: {
+        ALUResult o; ALU(A, B, r.op == S_SUB, o); R = o.result;
+        r.flags = (uint8_t)(o.flags.N << 3 | o.flags.Z << 2 | o.flags.C << 1 | o.flags.V);
+        break;
+    }
+    case S_MUL:    { MulOut m; mul_ss(A, B, m, false); R = m.low32; r.flags = (uint8_t)m.overflow; break; }
+    case S_MULH:   { MulOut m; mul_ss(A, B, m, false); R = m.high32; break; }
+    case S_MULHSU: { MulOut m; mul_su(A, B, m, false); R = m.high32; break; }
+    case S_MULHU:  { MulOut m; mul_uu(A, B, m, false); R = m.high32; break; }
+    case S_DIV: case S_REM: { DivPair d; div_signed(A, B, d, false); R = r.op == S_DIV ? d.q : d.r; r.flags = (uint8_t)d.overflow; break; }
+    case S_DIVU: case S_REMU: { DivOut d; divu(A, B, d, false); R = r.op == S_DIVU ? d.q : d.r; break; }
+    case S_SLL: sll(A, B, R); break;
+    case S_SRL: srl(A, B, R); break;
+    case S_SRA: sra(A, B, R); break;
+    case S_FADD: floatAddSub(A, B, false, R, rm); break;
+    case S_FSUB: floatAddSub(A, B, true, R, rm); break;
+    case S_FMUL: floatMultiply(A, B, R, rm); break;
+    case S_FDIV: floatDivide(A, B, R, rm); break;
+    case S_FSQRT: floatSqrt(A, R, rm); break;
+    }
+    r.r = (uint32_t)R.w[0];
+}
+
+// ============================= Format =============================
+inline char* putHex32(char* p, uint32_t v) {
+    static const char digits[] = "0123456789ABCDEF";
+    *p++ = '0'; *p++ = 'x';
+    for (int k = 28; k >= 0; k -= 4) *p++ = digits[(v >> k) & 15];
+    return p;
+}
+inline char* putText(char* p, const char* s) { while (*s) *p++ = *s++; return p; }
+inline char* putDec(char* p, uint64_t v) {
+    char t[20]; int n = 0;
+    do { t[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = t[--n];
+    return p;
+}
+
+// one output line; at most ~64 bytes
+inline char* formatRecord(char* p, const StreamRecord& r) {
+    if (r.err) {
+        p = putText(p, "error line "); p = putDec(p, r.line); *p++ = ':'; *p++ = ' ';
+        p = putText(p, kStreamErrorText[r.err]);
+        *p++ = '\n';
+        return p;
+    }
+    p = putText(p, kStreamOpName[r.op]); *p++ = ' ';
+    p = putHex32(p, r.a);
+    if (r.op != S_FSQRT) { *p++ = ' '; p = putHex32(p, r.b); }
+    if (r.op >= S_FADD) { *p++ = ' '; p = putText(p, kRoundName[r.rm]); }
+    *p++ = ' '; *p++ = '='; *p++ = ' ';
+    p = putHex32(p, r.r);
+    if (r.op <= S_SUB) {
+        p = putText(p, " nzcv=");
+        for (int k = 3; k >= 0; --k) *p++ = (char)('0' + ((r.flags >> k) & 1));
+    } else if (r.op == S_MUL || r.op == S_DIV || r.op == S_REM) {
+        p = putText(p, " ovf="); *p++ = (char)('0' + r.flags);
+    }
+    *p++ = '\n';
+    return p;
+}
+
+// ============================= Pipeline =============================
+struct StreamStats { uint64_t records = 0, errors = 0, bytesOut = 0; };
+
+inline StreamStats runStream(FILE* in, FILE* out, unsigned workers) {
+    if (!workers) workers = 1;
+    const size_t inFlight = 2 * (size_t)workers + 2;          // batches alive at once
+    vector<unique_ptr<StreamBatch>> pool;
+    BoundedQueue<StreamBatch*> freeQ(inFlight), parsedQ(inFlight), doneQ(inFlight);
+    for (size_t i = 0; i < inFlight; ++i) { pool.emplace_back(new StreamBatch); freeQ.push(pool.back().get()); }
+
+    thread parser([&]{
+        LineReader lr(in);
+        uint64_t line = 0, seq = 0;
+        StreamBatch* b = nullptr;
+        const char *s, *e; bool tooLong;
+        while (lr.next(s, e, tooLong)) {
+            ++line;
+            const char* t = s;
+            while (t < e && (*t == ' ' || *t == '\t' || *t == ',' || *t == '\r')) ++t;
+            if (!tooLong && (t == e || *t == '#')) continue;
+            if (!b) { freeQ.pop(b); b->seq = seq++; b->n = 0; }
+            StreamRecord& r = b->rec[b->n++];
+            r.line = line; r.err = E_NONE;
+            if (tooLong) r.err = E_LONG; else parseRecord(t, e, r);
+            if (b->n == kStreamBatch) { parsedQ.push(b); b = nullptr; }
+        }
+        if (b) parsedQ.push(b);
+        parsedQ.close();
+    });
+
+    mutex doneM; unsigned running = workers;
+    vector<thread> pool_;
+    for (unsigned w = 0; w < workers; ++w)
+        pool_.emplace_back([&]{
+            StreamBatch* b;
+            while (parsedQ.pop(b)) {
+                for (size_t i = 0; i < b->n; ++i) computeRecord(b->rec[i]);
+                doneQ.push(b);
+            }
+            lock_guard<mutex> lk(doneM);
+            if (--running == 0) doneQ.close();
+        });
+
+    // format in sequence: batches finish out of order, at most inFlight apart
+    StreamStats st;
+    vector<StreamBatch*> slot(inFlight, nullptr);
+    vector<char> outBuf(kStreamFlush + kStreamBatch * 80);
+    size_t used = 0;
+    uint64_t next = 0;
+    StreamBatch* b;
+    while (doneQ.pop(b)) {
+        slot[b->seq % inFlight] = b;
+        while ((b = slot[next % inFlight]) && b->seq == next) {
+            slot[next % inFlight] = nullptr;
+            char* p = &outBuf[used];
+            for (size_t i = 0; i < b->n; ++i) { p = formatRecord(p, b->rec[i]); st.errors += b->rec[i].err != E_NONE; }
+            used = p - &outBuf[0];
+            st.records += b->n;
+            freeQ.push(b);
+            ++next;
+            if (used >= kStreamFlush) { fwrite(&outBuf[0], 1, used, out); st.bytesOut += used; used = 0; }
+        }
+    }
+    fwrite(&outBuf[0], 1, used, out); st.bytesOut += used;
+    fflush(out);
+    parser.join();
+    for (thread& t : pool_) t.join();
+    return st;
+}
@@ -0,0 +1,124 @@
+// stream_verify.cpp - the streaming batch mode against expected output lines
+// Build: g++ -O2 -std=c++17 -pthread stream_verify.cpp -o stream_verify
+// Usage: stream_verify [--threads T]
+// Two checks run through runStream, with input and output in temporary files:
+//   cases  fixed records with their exact output line: every op, hex, decimal and float
+//          operands, rounding modes and every parse error. Skipped lines (blank, separators
+//          only, comments) must print nothing and leave the records around them intact.
+//   order  several batches of "add i 1" records must come back in input order as i+1.
+// Exit code: 0 all passed, 1 mismatch (first one reported), 2 usage error.
+#include "stream_ops.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// ============================== Cases ==============================
+// out: the expected line; "!text" expects "error line N: text"; nullptr: the line is skipped
+struct StreamCase { const char* in; const char* out; };
+
+static const StreamCase kCases[] = {
+    { "add 1 2",                   "add 0x00000001 0x00000002 = 0x00000003 nzcv=0000" },
+    { ",,,",                       nullptr },
+    { "add 0x7FFFFFFF 1",          "add 0x7FFFFFFF 0x00000001 = 0x80000000 nzcv=1001" },
+    { "",                          nullptr },
+    { "sub 5 7",                   "sub 0x00000005 0x00000007 = 0xFFFFFFFE nzcv=1000" },
+    { " , \t,",                    nullptr },
+    { "mul -15 -5",                "mul 0xFFFFFFF1 0xFFFFFFFB = 0x0000004B ovf=0" },
+    { "# comment",                 nullptr },
+    { "mulh 0x80000000 0x80000000", "mulh 0x80000000 0x80000000 = 0x40000000" },
+    { "mulhsu -1 0xFFFFFFFF",      "mulhsu 0xFFFFFFFF 0xFFFFFFFF = 0xFFFFFFFF" },
+    { "mulhu 0xFFFFFFFF 0xFFFFFFFF", "mulhu 0xFFFFFFFF 0xFFFFFFFF = 0xFFFFFFFE" },
+    { "div -7 2",                  "div 0xFFFFFFF9 0x00000002 = 0xFFFFFFFD ovf=0" },
+    { "rem -7 2",                  "rem 0xFFFFFFF9 0x00000002 = 0xFFFFFFFF ovf=0" },
+    { "div 0x80000000 -1",         "div 0x80000000 0xFFFFFFFF = 0x80000000 ovf=1" },
+    { "divu 7 0",                  "divu 0x00000007 0x00000000 = 0xFFFFFFFF" },
+    { "remu 7,0",                  "remu 0x00000007 0x00000000 = 0x00000007" },
+    { "sll 1 33",                  "sll 0x00000001 0x00000021 = 0x00000002" },
+    { "srl 0x80000001 31",         "srl 0x80000001 0x0000001F = 0x00000001" },
+    { "sra 0x80000000 4",          "sra 0x80000000 0x00000004 = 0xF8000000" },
+    { "fadd 1.5 2.25",             "fadd 0x3FC00000 0x40100000 rne = 0x40700000" },
+    { "fsub 1e-3 1e-3",            "fsub 0x3A83126F 0x3A83126F rne = 0x00000000" },
+    { "fmul 0x7F800000 0",         "fmul 0x7F800000 0x00000000 rne = 0x7FC00000" },
+    { "fdiv 1 3",                  "fdiv 0x3F800000 0x40400000 rne = 0x3EAAAAAB" },
+    { "fdiv 1 3 rtz",              "fdiv 0x3F800000 0x40400000 rtz = 0x3EAAAAAA" },
+    { "fsqrt 2 rup",               "fsqrt 0x40000000 rup = 0x3FB504F4" },
+    { "foo 1 2",                   "!unknown op" },
+    { "add 1",                     "!missing operand" },
+    { "fsqrt",                     "!missing operand" },
+    { "add 1 x",                   "!bad operand" },
+    { "add 1 0x100000000",         "!bad operand" },
+    { "add 1 2 rne",               "!unexpected field" },
+    { "fadd 1 2 rxx",              "!unexpected field" },
+    { "add 1 2 3 4 5 6",           "!unexpected field" },
+    { "add 1 2",                   "add 0x00000001 0x00000002 = 0x00000003 nzcv=0000" },
+};
+
+// ============================== Harness ==============================
+static string runText(const string& input, unsigned threads){
+    FILE* in = tmpfile(); FILE* out = tmpfile();
+    if(!in || !out){ fprintf(stderr, "cannot create temporary files\n"); exit(2); }
+    fwrite(input.data(), 1, input.size(), in); rewind(in);
+    runStream(in, out, threads);
+    fflush(out); rewind(out);
+    string s; char buf[1 << 16]; size_t got;
+    while((got = fread(buf, 1, sizeof buf, out)) > 0) s.append(buf, got);
+    fclose(in); fclose(out);
+    return s;
+}
+
+static vector<string> splitLines(const string& s){
+    vector<string> v; size_t p = 0;
+    while(p < s.size()){ size_t e = s.find('\n', p); if(e == string::npos) e = s.size(); v.push_back(s.substr(p, e - p)); p = e + 1; }
+    return v;
+}
+
+static bool compare(const char* check, const vector<string>& want, const vector<string>& got){
+    for(size_t i=0;i<want.size() || i<got.size();++i){
+        if(i < want.size() && i < got.size() && want[i] == got[i]) continue;
+        printf("%-6s MISMATCH at output line %zu\n  want: %s\n  got:  %s\n", check, i + 1,
+               i < want.size() ? want[i].c_str() : "(nothing)", i < got.size() ? got[i].c_str() : "(nothing)");
+        return false;
+    }
+    printf("%-6s ok (%zu lines)\n", check, want.size());
+    return true;
+}
+
+static bool checkCases(unsigned threads){
+    string input; vector<string> want;
+    size_t line = 0;
+    for(const StreamCase& c : kCases){
+        input += c.in; input += '\n'; ++line;
+        if(!c.out) continue;
+        want.push_back(c.out[0] == '!' ? "error line " + to_string(line) + ": " + (c.out + 1) : string(c.out));
+    }
+    input += "add " + string(kStreamLine + 8, '1') + " 2\n"; ++line;            // longer than a line may be
+    want.push_back("error line " + to_string(line) + ": line too long");
+    input += "sub 0 1";                                                         // no final newline
+    want.push_back("sub 0x00000000 0x00000001 = 0xFFFFFFFF nzcv=1000");
+    return compare("cases", want, splitLines(runText(input, threads)));
+}
+
+static bool checkOrder(unsigned threads){
+    const uint32_t n = 3 * (uint32_t)kStreamBatch + 17;
+    string input; vector<string> want;
+    char buf[80];
+    for(uint32_t i=0;i<n;++i){
+        input += "add " + to_string(i) + " 1\n";
+        snprintf(buf, sizeof buf, "add 0x%08X 0x00000001 = 0x%08X nzcv=0000", i, i + 1);
+        want.push_back(buf);
+    }
+    return compare("order", want, splitLines(runText(input, threads)));
+}
+
+int main(int argc, char** argv){
+    unsigned threads = thread::hardware_concurrency();
+    for(int i=1;i<argc;++i){
+        if(!strcmp(argv[i], "--threads") && i + 1 < argc) threads = (unsigned)atoi(argv[++i]);
+        else { fprintf(stderr, "usage: stream_verify [--threads T]\n"); return 2; }
+    }
+    bool ok = checkCases(threads);
+    ok = checkOrder(threads) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// trace.h - per-iteration datapath traces of the iterative MUL/DIV engines
+// Recording packs each step into one fixed-size record in a preallocated ring (no allocation,
+// no formatting, oldest steps overwritten once full); renderTrace turns the ring into
+// binary or hex tables only when asked. An engine records when its `trace` argument is true
+// and a ring is installed on the calling thread (traceInstall). Each engine loop is
+// instantiated with and without recording, so with trace off the loop is the untraced one.
+#pragma once
+
+#include "bits.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// ============================= Records =============================
+enum TraceUnit : uint8_t { T_MUL_SHIFTADD, T_DIV_RESTORING, T_DIV_NONRESTORING, T_DIV_SRT4, T_UNITS };
+
+constexpr uint8_t kTraceHeader = 0xFF;      // step value of an operation's first record
+
+// One step, 32 bytes. Fields per unit (register widths in wires):
+//   header        a = operand A, b = operand B (multiplicand/multiplier, dividend/divisor)
+//   shift-add     a = accumulator (64), b = multiplicand (64), c = multiplier (32), bit = added
+//   restoring     a = remainder (32), c = quotient (32), bit = quotient bit
+//   non-restoring a = remainder (34, two's complement), c = quotient (32), bit = quotient bit
+//   SRT radix-4   a = sum row (40), b = carry row (40), c = quotient Q (32), bit = digit (-2..2)
+struct TraceStep {
+    uint64_t a, b;
+    uint32_t c;
+    uint32_t op;        // operation number, low 32 bits
+    uint8_t unit, step;
+    int8_t bit;
+};
+
+// register snapshot for a record (wiring: the low storage word as is)
+template <int N>
+inline uint64_t traceWord(const Bits<N>& x) { static_assert(N <= 64, "trace registers are at most 64 wires"); return x.w[0]; }
+
+class TraceRing {
+public:
+    // capacity in steps, rounded up to a power of two; allocated once here
+    explicit TraceRing(size_t capacity = 1 << 16) {
+        size_t cap = 1;
+        while (cap < capacity) cap += cap;
+        buf.resize(cap);
+        mask = cap - 1;
+    }
+
+    // ---- recording (engines) ----
+    void begin(TraceUnit u, uint64_t a, uint64_t b) { unit = u; ++ops; put(kTraceHeader, a, b, 0, 0); }
+    void step(int i, uint64_t a, uint64_t b, uint32_t c, int bit) { put((uint8_t)i, a, b, c, (int8_t)bit); }
+
+    // ---- reading ----
+    size_t capacity() const { return buf.size(); }
+    size_t size() const { return head < buf.size() ? (size_t)head : buf.size(); }
+    uint64_t recorded() const { return head; }          // steps ever recorded, dropped ones included
+    uint64_t operations() const { return ops; }
+    const TraceStep& operator[](size_t i) const { return buf[(head - size() + i) & mask]; }   // 0 = oldest held
+    void clear() { head = 0; ops = 0; }
+
+private:
+    vector<TraceStep> buf;
+    size_t mask = 0;
+    uint64_t head = 0, ops = 0;
+    uint8_t unit = 0;
+
+    void put(uint8_t s, uint64_t a, uint64_t b, uint32_t c, int8_t bit) {
+        TraceStep& t = buf[head & mask];
+        t.a = a; t.b = b; t.c = c; t.op = (uint32_t)ops; t.unit = unit; t.step = s; t.bit = bit;
+        ++head;
+    }
+};
+
+// ---- the ring the engines on this thread record into (nullptr: none) ----
+inline thread_local TraceRing* tTraceRing = nullptr;
+
+inline TraceRing* traceInstall(TraceRing* ring) { TraceRing* old = tTraceRing; tTraceRing = ring; return old; }
+inline TraceRing* traceTarget(bool trace) { return trace ? tTraceRing : nullptr; }
+
+// ============================= Rendering (display side: host ints fine) =============================
+enum class TraceFormat { Hex, Binary };
+
+struct TraceColumn { const char* name; int field; int width; };   // field: 0 a, 1 b, 2 c, 3 bit
+struct TraceLayout { const char* title; const char* opA; const char* opB; int opWidth; TraceColumn col[4]; };
+
+static const TraceLayout kTraceLayout[T_UNITS] = {
+    { "MUL shift-add", "multiplicand", "multiplier", 32,
+      { { "accumulator", 0, 64 }, { "multiplicand", 1, 64 }, { "multiplier", 2, 32 }, { "add", 3, 1 } } },
+    { "DIV restoring", "dividend", "divisor", 32,
+      { { "remainder", 0, 32 }, { "quotient", 2, 32 }, { "qbit", 3, 1 }, { nullptr, 0, 0 } } },
+    { "DIV non-restoring", "dividend", "divisor", 32,
+      { { "remainder", 0, 34 }, { "quotient", 2, 32 }, { "qbit", 3, 1 }, { nullptr, 0, 0 } } },
+    { "DIV SRT radix-4", "dividend", "divisor", 32,
+      { { "sum row", 0, 40 }, { "carry row", 1, 40 }, { "Q", 2, 32 }, { "digit", 3, 2 } } },
+};
+
+inline void traceAppendValue(string& s, uint64_t v, int width, TraceFormat f) {
+    static const char digits[] = "0123456789ABCDEF";
+    if (f == TraceFormat::Hex) {
+        s += "0x";
+        for (int k = (width + 3) / 4 - 1; k >= 0; --k) s += digits[(v >> (4 * k)) & 15];
+    } else {
+        for (int k = width - 1; k >= 0; --k) { s += (char)('0' + ((v >> k) & 1)); if (k && k % 8 == 0) s += '_'; }
+    }
+}
+
+inline int traceCellWidth(int width, TraceFormat f) {
+    return f == TraceFormat::Hex ? 2 + (width + 3) / 4 : width + (width - 1) / 8;
+}
+
+inline void traceAppendPadded(string& s, const string& cell, int width) {
+    s += cell;
+    for (int k = (int)cell.size(); k < width; ++k) s += ' ';
+    s += "  ";
+}
+
+// The last `maxOps` operations held in the ring (all of them by default), one table each.
+// An operation whose first steps were already overwritten is skipped.
+inline string renderTrace(const TraceRing& ring, TraceFormat f = TraceFormat::Hex, size_t maxOps = (size_t)-1) {
+    vector<size_t> starts;
+    for (size_t i = 0; i < ring.size(); ++i) if (ring[i].step == kTraceHeader) starts.push_back(i);
+    size_t first = starts.size() > maxOps ? starts.size() - maxOps : 0;
+    string s;
+    for (size_t k = first; k < starts.size(); ++k) {
+        const TraceStep& h = ring[starts[k]];
+        const TraceLayout& L = kTraceLayout[h.unit];
+        s += "op " + to_string(h.op) + ": " + L.title + "  " + L.opA + "=";
+        traceAppendValue(s, h.a, L.opWidth, f);
+        s += string(" ") + L.opB + "=";
+        traceAppendValue(s, h.b, L.opWidth, f);
+        s += "\n step  ";
+        for (const TraceColumn& c : L.col)
+            if (c.name) traceAppendPadded(s, c.name, c.field == 3 ? 5 : traceCellWidth(c.width, f));
+        while (s.back() == ' ') s.pop_back();
+        s += "\n";
+        size_t end = k + 1 < starts.size() ? starts[k + 1] : ring.size();
+        for (size_t i = starts[k] + 1; i < end; ++i) {
+            const TraceStep& t = ring[i];
+            string n = to_string(t.step);
+            s += string(5 - n.size(), ' ') + n + "  ";
+            for (const TraceColumn& c : L.col) {
+                if (!c.name) continue;
+                string cell;
+                if (c.field == 3) cell = to_string(t.bit);
+                else traceAppendValue(cell, c.field == 0 ? t.a : c.field == 1 ? t.b : t.c, c.width, f);
+                traceAppendPadded(s, cell, c.field == 3 ? 5 : traceCellWidth(c.width, f));
+            }
+            while (s.back() == ' ') s.pop_back();
+            s += "\n";
+        }
+    }
+    return s;
+}
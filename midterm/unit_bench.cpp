@@ -0,0 +1,291 @@
+// unit_bench.cpp - ns/op, heap allocations/op and bytes/op of every unit on fixed operand sets
+// Build: g++ -O2 -std=c++17 unit_bench.cpp -o unit_bench
+//        (-D*_ADDER / -DMUL_ENGINE / -DDIV_ENGINE / -DFLOAT_DIV_ENGINE pick the units, as everywhere)
+// Usage: unit_bench [--ops N] [--repeat R] [--filter TEXT] [--json FILE] [--baseline FILE] [--tolerance PCT]
+//                   [--trace STEPS]
+// Each unit runs three operand sets built from fixed seeds: small (|x| < 256, small integral
+// floats), random (uniform words, finite floats) and edge (the corner cases of that unit:
+// full carry chains, all-ones magnitudes and quotients, signed edge cases, subnormals,
+// cancellation). Edge is not the slowest set: its fixed patterns predict well on the host.
+// The median of R timed passes is reported as ns/op. Every pass is followed by a pass of a
+// calibration kernel that no unit selection reaches (addBits on 32 wires), and "rel" is the
+// median of the unit/calibration ratios, so host speed and drift during the run cancel.
+// --baseline compares rel against a stored run (bench_baseline.json: the default build):
+// a row slower by more than PCT percent (default 25) or allocating differently fails
+// (exit 1). Hosts still differ in cache and branch behaviour, so a failure on a machine other
+// than the recording one is a hint, not a verdict.
+// --trace runs the MUL/DIV rows with their step traces recorded into a ring of STEPS steps
+// (the cost of recording; iterative engines only).
+#include "float_divsqrt.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// ---- allocation counting (every operator new in the process goes through here) ----
+// kept out of line so the compiler does not pair the inlined malloc/free with new/delete
+static uint64_t gAllocs = 0, gAllocBytes = 0;
+
+__attribute__((noinline)) void* operator new(size_t n){
+    gAllocs++; gAllocBytes += n;
+    if(void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ---- operand sets (TEST side: host arithmetic fine) ----
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+enum Dist { SMALL, RANDOM, EDGE };
+static const char* const kDistName[] = { "small", "random", "edge" };
+
+enum Kind { ALU_PAIR, MUL_SS, MUL_SU, MUL_UU, DIV_SIGNED, DIV_UNSIGNED, FLOAT, FLOAT_POSITIVE };
+
+static uint32_t floatBitsOf(float f){ uint32_t u; memcpy(&u, &f, 4); return u; }
+
+// operand i of a set from the pair's one draw; `second` picks the other operand of the pair,
+// which reads the draw with its halves swapped unless it is derived from the first operand
+static uint32_t operand(Kind k, Dist d, size_t i, bool second, uint64_t draw){
+    uint64_t x = second ? draw >> 32 | draw << 32 : draw;
+    bool isFloat = k == FLOAT || k == FLOAT_POSITIVE;
+    bool isUnsigned = k == MUL_UU || k == DIV_UNSIGNED || k == FLOAT_POSITIVE || (k == MUL_SU && second);
+    bool isDivisor = (k == DIV_SIGNED || k == DIV_UNSIGNED) && second;
+    if(d == SMALL){
+        int v = isUnsigned ? (int)(x % 256) : (int)(x % 511) - 255;
+        if(isDivisor && !v) v = 1;
+        return isFloat ? floatBitsOf((float)v) : (uint32_t)v;
+    }
+    if(d == RANDOM){
+        uint32_t u = (uint32_t)x;
+        if(isFloat && (((u >> 23) & 0xFF) == 0xFF || ((u >> 23) & 0xFF) == 0)) u ^= 0x40000000u;
+        if(k == FLOAT_POSITIVE) u &= 0x7FFFFFFFu;
+        if(isDivisor && !u) u = 1;
+        return u;
+    }
+    // edge: full carry chains, all-ones magnitudes (every multiplier bit adds), all-ones
+    // quotients and the signed edge cases, subnormals and near-total cancellation
+    switch(k){
+    case ALU_PAIR: {
+        static const uint32_t pairs[][2] = { { 0xFFFFFFFFu, 1 }, { 0x7FFFFFFFu, 1 }, { 0, 1 }, { 0x80000000u, 0x7FFFFFFFu } };
+        return pairs[i % 4][second];
+    }
+    case MUL_SS: return i % 2 ? 0x80000001u : 0x7FFFFFFFu;
+    case MUL_SU: return second ? 0xFFFFFFFFu : (i % 2 ? 0x80000001u : 0x7FFFFFFFu);
+    case MUL_UU: return 0xFFFFFFFFu;
+    case DIV_SIGNED:   return second ? (i % 3 == 2 ? 0xFFFFFFFFu : 1u) : (i % 2 ? 0x80000000u : 0x7FFFFFFFu);
+    case DIV_UNSIGNED: return second ? 1u + (uint32_t)(i % 3) : 0xFFFFFFFFu;
+    case FLOAT: {
+        uint32_t u = (uint32_t)x & 0x807FFFFFu;                     // subnormal
+        if(i % 2){                                                  // x - x(1 - 2^-23): cancels to one ulp
+            u = ((uint32_t)draw & 0x3FFFFFFFu) | 0x00800000u;
+            if(second) u = (u - 1) ^ 0x80000000u;
+        }
+        return u;
+    }
+    case FLOAT_POSITIVE: return ((uint32_t)x & 0x007FFFFFu) | 1u;
+    }
+    return 0;
+}
+
+// ---- units ----
+struct Unit {
+    const char* name;
+    Kind kind;
+    void (*run)(const Bits<32>& a, const Bits<32>& b, Bits<32>& sink);
+};
+
+static void aluAdd(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ ALUResult r; ALU(a, b, false, r); s = r.result; }
+static void aluSub(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ ALUResult r; ALU(a, b, true, r); s = r.result; }
+static bool gTrace = false;   // --trace: MUL/DIV record their steps
+static void mulSS(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ MulOut m; mul_ss(a, b, m, gTrace); s = m.high32; }
+static void mulSU(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ MulOut m; mul_su(a, b, m, gTrace); s = m.high32; }
+static void mulUU(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ MulOut m; mul_uu(a, b, m, gTrace); s = m.high32; }
+static void divU(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ DivOut d; divu(a, b, d, gTrace); s = d.q; }
+static void divS(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ DivPair d; div_signed(a, b, d, gTrace); s = d.q; }
+static void fAdd(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ floatAddSub(a, b, false, s); }
+static void fSub(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ floatAddSub(a, b, true, s); }
+static void fMul(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ floatMultiply(a, b, s); }
+static void fDiv(const Bits<32>& a, const Bits<32>& b, Bits<32>& s){ floatDivide(a, b, s); }
+static void fSqrt(const Bits<32>& a, const Bits<32>&, Bits<32>& s){ floatSqrt(a, s); }
+
+static const Unit kUnits[] = {
+    { "ALU.add", ALU_PAIR, aluAdd },             { "ALU.sub", ALU_PAIR, aluSub },
+    { "mul_ss", MUL_SS, mulSS },                 { "mul_su", MUL_SU, mulSU },
+    { "mul_uu", MUL_UU, mulUU },
+    { "divu", DIV_UNSIGNED, divU },              { "div_signed", DIV_SIGNED, divS },
+    { "floatAddSub.add", FLOAT, fAdd },          { "floatAddSub.sub", FLOAT, fSub },
+    { "floatMultiply", FLOAT, fMul },            { "floatDivide", FLOAT, fDiv },
+    { "floatSqrt", FLOAT_POSITIVE, fSqrt },
+};
+
+struct Result { string unit, dist; double ns = 0, rel = 0, allocs = 0, bytes = 0; };
+
+// calibration kernel: the ripple fullAdder loop on its own fixed random operands, the same
+// on every build and for every row
+static void calibrationPass(size_t n, vector<Bits<32>>& out){
+    static vector<Bits<32>> a, b;
+    if(a.size() != n){
+        uint64_t x = 0x243F6A8885A308D3ull;
+        a.resize(n); b.resize(n);
+        for(size_t i=0;i<n;++i){ x = x * 6364136223846793005ull + 1442695040888963407ull; a[i] = intToBits((long long)(uint32_t)(x >> 32)); b[i] = intToBits((long long)(uint32_t)x); }
+    }
+    for(size_t i=0;i<n;++i){ int c = 0; addBits(a[i], b[i], out[i], c); }
+}
+
+static Result measure(const Unit& u, Dist d, size_t n, int repeat){
+    rngState = 88172645463325252ull ^ (uint64_t)(d + 1) * 0x9E3779B97F4A7C15ull;   // same operands every run
+    vector<Bits<32>> a(n), b(n), out(n);
+    for(size_t i=0;i<n;++i){
+        uint64_t draw = rnd64();
+        a[i] = intToBits((long long)operand(u.kind, d, i, false, draw));
+        b[i] = intToBits((long long)operand(u.kind, d, i, true, draw));
+    }
+    calibrationPass(n, out);                                   // operands built outside the timing
+    vector<double> passes(repeat), rel(repeat);
+    uint64_t allocs = 0, bytes = 0;
+    for(int r=0;r<repeat;++r){
+        uint64_t a0 = gAllocs, b0 = gAllocBytes;
+        auto t0 = chrono::steady_clock::now();
+        for(size_t i=0;i<n;++i) u.run(a[i], b[i], out[i]);
+        auto t1 = chrono::steady_clock::now();
+        allocs = gAllocs - a0; bytes = gAllocBytes - b0;
+        calibrationPass(n, out);
+        auto t2 = chrono::steady_clock::now();
+        passes[r] = chrono::duration<double, nano>(t1 - t0).count() / (double)n;
+        rel[r] = chrono::duration<double>(t1 - t0).count() / chrono::duration<double>(t2 - t1).count();
+    }
+    sort(passes.begin(), passes.end());
+    sort(rel.begin(), rel.end());
+    Result res;
+    res.unit = u.name; res.dist = kDistName[d];
+    res.ns = passes[passes.size() / 2];
+    res.rel = rel[rel.size() / 2];
+    res.allocs = (double)allocs / (double)n; res.bytes = (double)bytes / (double)n;
+    return res;
+}
+
+// ---- JSON (one result object per line, so a stored file reads back line by line) ----
+static string configJson(){
+    return string("{\"alu_adder\": \"") + ALU_ADDER::name() + "\", \"mul_engine\": \"" + MUL_ENGINE::name() +
+           "\", \"mul_adder\": \"" + MUL_ADDER::name() + "\", \"div_engine\": \"" + DIV_ENGINE::name() +
+           "\", \"div_adder\": \"" + DIV_ADDER::name() + "\", \"float_adder\": \"" + FLOAT_ADDER::name() +
+           "\", \"float_div_engine\": \"" + FLOAT_DIV_ENGINE::name() + "\"" + (gTrace ? ", \"trace\": true}" : "}");
+}
+
+static void writeJson(const string& path, const vector<Result>& rs){
+    FILE* f = fopen(path.c_str(), "w");
+    if(!f){ fprintf(stderr, "cannot write %s\n", path.c_str()); return; }
+    fprintf(f, "{\n  \"config\": %s,\n  \"results\": [\n", configJson().c_str());
+    for(size_t i=0;i<rs.size();++i)
+        fprintf(f, "    {\"unit\": \"%s\", \"dist\": \"%s\", \"ns_per_op\": %.2f, \"rel\": %.4f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f}%s\n",
+                rs[i].unit.c_str(), rs[i].dist.c_str(), rs[i].ns, rs[i].rel, rs[i].allocs, rs[i].bytes, i + 1 < rs.size() ? "," : "");
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+static bool jsonField(const string& line, const string& key, string& v){
+    size_t p = line.find("\"" + key + "\":");
+    if(p == string::npos) return false;
+    p = line.find_first_not_of(" ", p + key.size() + 3);
+    if(p == string::npos) return false;
+    if(line[p] == '"'){ size_t e = line.find('"', p + 1); v = line.substr(p + 1, e - p - 1); }
+    else v = line.substr(p, line.find_first_of(",}", p) - p);
+    return true;
+}
+
+static map<string, Result> readJson(const string& path, string& config){
+    map<string, Result> m;
+    ifstream in(path);
+    string line, v;
+    while(getline(in, line)){
+        size_t c = line.find("\"config\": ");
+        if(c != string::npos){ config = line.substr(c + 10); config = config.substr(0, config.rfind('}') + 1); continue; }
+        Result r;
+        if(!jsonField(line, "unit", r.unit) || !jsonField(line, "dist", r.dist)) continue;
+        if(jsonField(line, "ns_per_op", v)) r.ns = atof(v.c_str());
+        if(jsonField(line, "rel", v)) r.rel = atof(v.c_str());
+        if(jsonField(line, "allocs_per_op", v)) r.allocs = atof(v.c_str());
+        if(jsonField(line, "bytes_per_op", v)) r.bytes = atof(v.c_str());
+        m[r.unit + "/" + r.dist] = r;
+    }
+    return m;
+}
+
+static bool parseU64(const char* s, uint64_t& v){ char* e; v = strtoull(s, &e, 0); return *s && !*e; }
+
+static int usage(){
+    fprintf(stderr, "usage: unit_bench [--ops N] [--repeat R] [--filter TEXT] [--json FILE] [--baseline FILE] [--tolerance PCT] [--trace STEPS]\n");
+    return 2;
+}
+
+int main(int argc, char** argv){
+    size_t n = 20000; int repeat = 5; double tolerance = 25;
+    size_t traceSteps = 0;
+    string filter, jsonPath, basePath;
+    for(int i=1;i<argc;++i){
+        string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        uint64_t x = 0;
+        if(arg == "--ops" && (v = next()) && parseU64(v, x) && x) n = x;
+        else if(arg == "--repeat" && (v = next()) && parseU64(v, x) && x) repeat = (int)x;
+        else if(arg == "--tolerance" && (v = next())) tolerance = atof(v);
+        else if(arg == "--filter" && (v = next())) filter = v;
+        else if(arg == "--json" && (v = next())) jsonPath = v;
+        else if(arg == "--baseline" && (v = next())) basePath = v;
+        else if(arg == "--trace" && (v = next()) && parseU64(v, x) && x) traceSteps = x;
+        else return usage();
+    }
+    TraceRing ring(traceSteps ? traceSteps : 1);   // allocated before any timing
+    if(traceSteps){ gTrace = true; traceInstall(&ring); }
+    map<string, Result> base;
+    if(!basePath.empty()){
+        string config;
+        base = readJson(basePath, config);
+        if(base.empty()){ fprintf(stderr, "no results in %s\n", basePath.c_str()); return 2; }
+        if(config != configJson()) printf("note: %s was recorded with different units: %s\n\n", basePath.c_str(), config.c_str());
+    }
+
+    printf("%zu ops x %d passes per row; ALU %s, MUL %s, DIV %s, FLOAT adder %s, FLOAT div %s%s\n\n", n, repeat,
+           ALU_ADDER::name(), MUL_ENGINE::name(), DIV_ENGINE::name(), FLOAT_ADDER::name(), FLOAT_DIV_ENGINE::name(),
+           gTrace ? "; MUL/DIV traced" : "");
+    printf("%-16s %-7s %10s %8s %10s %10s", "unit", "dist", "ns/op", "rel", "allocs/op", "bytes/op");
+    if(!base.empty()) printf(" %8s %7s  %s", "base rel", "ratio", "check");
+    printf("\n");
+
+    vector<Result> rs;
+    int regressions = 0;
+    for(const Unit& u : kUnits){
+        if(!filter.empty() && string(u.name).find(filter) == string::npos) continue;
+        for(Dist d : { SMALL, RANDOM, EDGE }){
+            Result r = measure(u, d, n, repeat);
+            rs.push_back(r);
+            printf("%-16s %-7s %10.1f %8.2f %10.3f %10.1f", r.unit.c_str(), r.dist.c_str(), r.ns, r.rel, r.allocs, r.bytes);
+            if(!base.empty()){
+                auto it = base.find(r.unit + "/" + r.dist);
+                if(it == base.end() || it->second.rel <= 0) printf(" %8s %7s  new", "-", "-");
+                else {
+                    double ratio = r.rel / it->second.rel;
+                    bool slow = ratio > 1 + tolerance / 100;
+                    bool allocs = fabs(r.allocs - it->second.allocs) > 5e-5 || fabs(r.bytes - it->second.bytes) > 5e-3;   // stored rounding
+                    regressions += slow || allocs;
+                    printf(" %8.2f %7.2f  %s", it->second.rel, ratio, slow ? "SLOWER" : allocs ? "ALLOCS" : "ok");
+                }
+            }
+            printf("\n");
+            fflush(stdout);
+        }
+    }
+    if(!jsonPath.empty()) writeJson(jsonPath, rs);
+    if(!base.empty()) printf("\n%d of %zu rows regressed (tolerance %.0f%%)\n", regressions, rs.size(), tolerance);
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,417 @@
+// verify.cpp - exhaustive and randomized verifier for the integer units against host arithmetic
+// Build: g++ -O2 -std=c++17 -pthread verify.cpp -o verify
+//        (add -mavx2 for fast --sliced runs; the *_ADDER / *_ENGINE macros pick what is verified)
+// Usage: verify [--units alu,mul,div,shift] [--sweep] [--random N] [--seed S] [--range LO:HI]
+//               [--partners V,V,...] [--threads T] [--sliced] [--checkpoint FILE] [--resume]
+//
+// --sweep   every x in [LO,HI) (default all 2^32) paired with each partner value on both
+//           sides, with itself, and with a scrambled copy of itself: (x,p) (p,x) (x,x) (x,mix(x))
+// --random  N pairs per operation drawn from the 2^64 pair space; pair i depends only on
+//           (seed, i), so a reported index reproduces on any thread count
+// Work is cut into chunks that threads take in order. The checkpoint records the first chunk
+// not yet finished, so --resume repeats at most one chunk per thread.
+// Exit code: 0 all passed, 1 mismatch (first one reported), 2 usage error.
+#include "bitslice.h"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================== Operations & host reference ==============================
+enum Op { OP_ADD, OP_SUB, OP_MULSS, OP_MULSU, OP_MULUU, OP_DIVU, OP_DIVS, OP_SLL, OP_SRL, OP_SRA, OP_COUNT };
+static const char* kOpName[OP_COUNT] = { "ALU add", "ALU sub", "mul_ss", "mul_su", "mul_uu", "divu", "div_signed", "sll", "srl", "sra" };
+
+// everything a unit reports, flattened to host ints for comparison
+struct Outcome {
+    uint32_t lo = 0, hi = 0;       // ALU, shifts: result / MUL: low32, high32 / DIV: q, r
+    int n = 0, z = 0, c = 0, v = 0; // ALU flags; MUL/DIV: overflow in v
+    bool operator==(const Outcome& o) const { return lo==o.lo && hi==o.hi && n==o.n && z==o.z && c==o.c && v==o.v; }
+};
+
+static Outcome reference(Op op, uint32_t a, uint32_t b){
+    Outcome e;
+    int32_t sa = (int32_t)a, sb = (int32_t)b;
+    switch(op){
+    case OP_ADD: case OP_SUB: {
+        uint32_t opB = op==OP_SUB ? (uint32_t)(0u - b) : b;     // the unit adds the negated operand
+        uint64_t wide = (uint64_t)a + opB;
+        uint32_t r = (uint32_t)wide;
+        e.lo = r; e.n = (int)(r >> 31); e.z = r==0; e.c = (int)(wide >> 32);
+        uint32_t bs = op==OP_SUB ? ~b : b;                         // sign of the operand actually added
+        e.v = (int)((~(a ^ bs) & (a ^ r)) >> 31);
+        break; }
+    case OP_MULSS: {
+        int64_t p = (int64_t)sa * sb;
+        e.lo = (uint32_t)p; e.hi = (uint32_t)((uint64_t)p >> 32); e.v = p != (int64_t)(int32_t)p;
+        break; }
+    case OP_MULSU: { int64_t p = (int64_t)sa * (int64_t)b; e.lo = (uint32_t)p; e.hi = (uint32_t)((uint64_t)p >> 32); break; }
+    case OP_MULUU: { uint64_t p = (uint64_t)a * b; e.lo = (uint32_t)p; e.hi = (uint32_t)(p >> 32); break; }
+    case OP_DIVU:
+        if(!b){ e.lo = 0xFFFFFFFFu; e.hi = a; }
+        else { e.lo = a / b; e.hi = a % b; }
+        break;
+    case OP_DIVS:
+        if(!b){ e.lo = 0xFFFFFFFFu; e.hi = a; }
+        else if(sa==INT_MIN && sb==-1){ e.lo = (uint32_t)INT_MIN; e.hi = 0; e.v = 1; }
+        else { e.lo = (uint32_t)(sa / sb); e.hi = (uint32_t)(sa % sb); }
+        break;
+    case OP_SLL: e.lo = a << (b & 31); break;                   // shamt = low 5 bits of b
+    case OP_SRL: e.lo = a >> (b & 31); break;
+    case OP_SRA: e.lo = (uint32_t)(sa >> (b & 31)); break;     // arithmetic on the host
+    default: break;
+    }
+    return e;
+}
+
+static uint32_t u32(const Bits<32>& x){ return (uint32_t)bitsToInt(x); }
+
+// run one block through the units (scalar or bit-sliced) and flatten the outputs
+struct Block {
+    vector<Bits<32>> a, b;
+    vector<int> sub;
+    vector<ALUResult> alu; vector<MulOut> mul; vector<DivOut> du; vector<DivPair> ds; vector<Bits<32>> sh;
+    vector<Outcome> got;
+    explicit Block(size_t n) : a(n), b(n), sub(n), alu(n), mul(n), du(n), ds(n), sh(n), got(n) {}
+};
+
+static void runUnits(Op op, Block& k, size_t n, bool sliced){
+    switch(op){
+    case OP_ADD: case OP_SUB:
+        for(size_t i=0;i<n;++i) k.sub[i] = op==OP_SUB;
+        if(sliced) ALU_batch(k.a.data(), k.b.data(), k.sub.data(), k.alu.data(), n);
+        else for(size_t i=0;i<n;++i) ALU(k.a[i], k.b[i], op==OP_SUB, k.alu[i]);
+        for(size_t i=0;i<n;++i){
+            const ALUResult& r = k.alu[i]; Outcome& g = k.got[i];
+            g = Outcome(); g.lo = u32(r.result); g.n = r.flags.N; g.z = r.flags.Z; g.c = r.flags.C; g.v = r.flags.V;
+        }
+        break;
+    case OP_MULSS: case OP_MULSU: case OP_MULUU:
+        if(sliced){
+            if(op==OP_MULSS) mul_ss_batch(k.a.data(), k.b.data(), k.mul.data(), n);
+            else if(op==OP_MULSU) mul_su_batch(k.a.data(), k.b.data(), k.mul.data(), n);
+            else mul_uu_batch(k.a.data(), k.b.data(), k.mul.data(), n);
+        } else for(size_t i=0;i<n;++i){
+            if(op==OP_MULSS) mul_ss(k.a[i], k.b[i], k.mul[i], false);
+            else if(op==OP_MULSU) mul_su(k.a[i], k.b[i], k.mul[i], false);
+            else mul_uu(k.a[i], k.b[i], k.mul[i], false);
+        }
+        for(size_t i=0;i<n;++i){ Outcome& g = k.got[i]; g = Outcome(); g.lo = u32(k.mul[i].low32); g.hi = u32(k.mul[i].high32); g.v = k.mul[i].overflow; }
+        break;
+    case OP_DIVU:   // the sliced kernel is the restoring divider; scalar goes through DIV_ENGINE
+        if(sliced) divu_restoring_batch(k.a.data(), k.b.data(), k.du.data(), n);
+        else for(size_t i=0;i<n;++i) divu(k.a[i], k.b[i], k.du[i], false);
+        for(size_t i=0;i<n;++i){ Outcome& g = k.got[i]; g = Outcome(); g.lo = u32(k.du[i].q); g.hi = u32(k.du[i].r); g.v = k.du[i].overflow; }
+        break;
+    case OP_DIVS:
+        if(sliced) div_signed_batch(k.a.data(), k.b.data(), k.ds.data(), n);
+        else for(size_t i=0;i<n;++i) div_signed(k.a[i], k.b[i], k.ds[i], false);
+        for(size_t i=0;i<n;++i){ Outcome& g = k.got[i]; g = Outcome(); g.lo = u32(k.ds[i].q); g.hi = u32(k.ds[i].r); g.v = k.ds[i].overflow; }
+        break;
+    case OP_SLL: case OP_SRL: case OP_SRA:   // no sliced kernel: the barrel shifter runs scalar either way
+        for(size_t i=0;i<n;++i){
+            if(op==OP_SLL) sll(k.a[i], k.b[i], k.sh[i]);
+            else if(op==OP_SRL) srl(k.a[i], k.b[i], k.sh[i]);
+            else sra(k.a[i], k.b[i], k.sh[i]);
+        }
+        for(size_t i=0;i<n;++i){ Outcome& g = k.got[i]; g = Outcome(); g.lo = u32(k.sh[i]); }
+        break;
+    default: break;
+    }
+}
+
+// ============================== Work: jobs, chunks, pair generation ==============================
+enum Pairing { PAIR_X_P, PAIR_P_X, PAIR_X_X, PAIR_X_MIX, PAIR_RANDOM };
+
+struct Job { Op op; Pairing pairing; uint32_t partner; uint64_t first, count; };
+
+static uint64_t splitmix64(uint64_t x){
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+// a bijection on 32 bits, so (x, mix(x)) still visits every second operand once
+static uint32_t mix32(uint32_t x){ x ^= x >> 16; x *= 0x7FEB352Du; x ^= x >> 15; x *= 0x846CA68Bu; x ^= x >> 16; return x; }
+
+static const uint32_t kEdges[] = { 0u, 1u, 2u, 0xFFFFFFFFu, 0xFFFFFFFEu, 0x80000000u, 0x7FFFFFFFu, 0x80000001u, 0x0000FFFFu, 0xFFFF0000u };
+
+static void pairAt(const Job& j, uint64_t index, uint64_t seed, uint32_t& a, uint32_t& b){
+    uint32_t x = (uint32_t)index;
+    a = b = 0;
+    switch(j.pairing){
+    case PAIR_X_P:   a = x; b = j.partner; break;
+    case PAIR_P_X:   a = j.partner; b = x; break;
+    case PAIR_X_X:   a = x; b = x; break;
+    case PAIR_X_MIX: a = x; b = mix32(x); break;
+    case PAIR_RANDOM: {
+        uint64_t r = splitmix64(seed ^ splitmix64(index * OP_COUNT + j.op));
+        a = (uint32_t)r; b = (uint32_t)(r >> 32);
+        uint64_t pick = splitmix64(r);
+        if((pick & 7) == 0) a = kEdges[(pick >> 8) % (sizeof kEdges / sizeof kEdges[0])];   // 1 in 8: edge value
+        if(((pick >> 3) & 7) == 0) b = kEdges[(pick >> 16) % (sizeof kEdges / sizeof kEdges[0])];
+        if(((pick >> 6) & 3) == 0) b >>= (pick >> 24) % 32;                                  // small divisors
+        break; }
+    }
+}
+
+static string describePairing(const Job& j){
+    char buf[64];
+    switch(j.pairing){
+    case PAIR_X_P:   snprintf(buf, sizeof buf, "(x, 0x%08X)", j.partner); break;
+    case PAIR_P_X:   snprintf(buf, sizeof buf, "(0x%08X, x)", j.partner); break;
+    case PAIR_X_X:   snprintf(buf, sizeof buf, "(x, x)"); break;
+    case PAIR_X_MIX: snprintf(buf, sizeof buf, "(x, mix(x))"); break;
+    default:         snprintf(buf, sizeof buf, "random"); break;
+    }
+    return buf;
+}
+
+// ============================== Driver ==============================
+struct Options {
+    bool units[4] = { true, true, true, true };   // alu, mul, div, shift
+    bool sweep = false, sliced = false, resume = false;
+    uint64_t randomPairs = 0, seed = 1;
+    uint64_t lo = 0, hi = 1ull << 32;
+    vector<uint32_t> partners = { 0u, 1u, 0xFFFFFFFFu, 0x80000000u, 0x7FFFFFFFu };
+    unsigned threads = 0;
+    string checkpoint;
+};
+
+struct Mismatch { bool found = false; size_t job = 0; uint64_t index = 0; uint32_t a = 0, b = 0; Outcome want, got; };
+
+constexpr uint64_t kChunk = 1u << 16;   // pairs per work chunk
+constexpr size_t kBlock = 4096;         // pairs per unit call
+
+struct Run {
+    const Options& opt;
+    vector<Job> jobs;
+    vector<uint64_t> chunkStart;        // first global chunk of each job
+    uint64_t totalChunks = 0;
+    string config;                      // what a checkpoint must match to be resumed
+
+    atomic<uint64_t> nextChunk{0};
+    atomic<uint64_t> pairsDone{0};
+    atomic<bool> stop{false};
+    mutex lock;                         // guards inFlight, firstBad
+    vector<uint64_t> inFlight;          // chunk each thread is on (UINT64_MAX = idle)
+    Mismatch firstBad;
+
+    explicit Run(const Options& o) : opt(o) {}
+
+    void plan(){
+        vector<Op> ops;
+        if(opt.units[0]){ ops.push_back(OP_ADD); ops.push_back(OP_SUB); }
+        if(opt.units[1]){ ops.push_back(OP_MULSS); ops.push_back(OP_MULSU); ops.push_back(OP_MULUU); }
+        if(opt.units[2]){ ops.push_back(OP_DIVU); ops.push_back(OP_DIVS); }
+        if(opt.units[3]){ ops.push_back(OP_SLL); ops.push_back(OP_SRL); ops.push_back(OP_SRA); }
+        for(Op op : ops){
+            if(opt.sweep){
+                for(uint32_t p : opt.partners){ jobs.push_back({op, PAIR_X_P, p, opt.lo, opt.hi - opt.lo}); jobs.push_back({op, PAIR_P_X, p, opt.lo, opt.hi - opt.lo}); }
+                jobs.push_back({op, PAIR_X_X, 0, opt.lo, opt.hi - opt.lo});
+                jobs.push_back({op, PAIR_X_MIX, 0, opt.lo, opt.hi - opt.lo});
+            }
+            if(opt.randomPairs) jobs.push_back({op, PAIR_RANDOM, 0, 0, opt.randomPairs});
+        }
+        for(const Job& j : jobs){ chunkStart.push_back(totalChunks); totalChunks += (j.count + kChunk - 1) / kChunk; }
+
+        ostringstream c;
+        c << "units=" << opt.units[0] << opt.units[1] << opt.units[2] << opt.units[3] << " sweep=" << opt.sweep << " random=" << opt.randomPairs
+          << " seed=" << opt.seed << " range=" << opt.lo << ":" << opt.hi << " sliced=" << opt.sliced << " partners=";
+        for(uint32_t p : opt.partners) c << p << ",";
+        c << " alu=" << ALU_ADDER::name() << " mul=" << MUL_ENGINE::name() << " mul_adder=" << MUL_ADDER::name()
+          << " div=" << DIV_ENGINE::name() << " div_adder=" << DIV_ADDER::name();
+        config = c.str();
+    }
+
+    // global chunk -> (job, first pair index, pair count)
+    void locate(uint64_t chunk, size_t& job, uint64_t& first, uint64_t& count) const {
+        size_t j = 0;
+        while(j + 1 < jobs.size() && chunkStart[j + 1] <= chunk) ++j;
+        uint64_t off = (chunk - chunkStart[j]) * kChunk;
+        job = j; first = jobs[j].first + off;
+        count = jobs[j].count - off < kChunk ? jobs[j].count - off : kChunk;
+    }
+
+    // every chunk below this is finished
+    uint64_t watermark(){
+        lock_guard<mutex> g(lock);
+        uint64_t w = nextChunk.load();
+        for(uint64_t c : inFlight) if(c < w) w = c;
+        return w < totalChunks ? w : totalChunks;
+    }
+
+    void worker(unsigned id){
+        Block k(kBlock);
+        for(;;){
+            if(stop.load()) break;
+            uint64_t chunk;
+            {
+                lock_guard<mutex> g(lock);
+                chunk = nextChunk.fetch_add(1);
+                inFlight[id] = chunk;
+            }
+            if(chunk >= totalChunks) break;
+            size_t job; uint64_t first, count;
+            locate(chunk, job, first, count);
+            const Job& j = jobs[job];
+            for(uint64_t done = 0; done < count && !stop.load(); done += kBlock){
+                size_t n = (size_t)(count - done < kBlock ? count - done : kBlock);
+                for(size_t i=0;i<n;++i){
+                    uint32_t a, b; pairAt(j, first + done + i, opt.seed, a, b);
+                    k.a[i] = intToBits((int)a); k.b[i] = intToBits((int)b);
+                }
+                runUnits(j.op, k, n, opt.sliced);
+                for(size_t i=0;i<n;++i){
+                    uint32_t a = u32(k.a[i]), b = u32(k.b[i]);
+                    Outcome want = reference(j.op, a, b);
+                    if(want == k.got[i]) continue;
+                    lock_guard<mutex> g(lock);
+                    uint64_t idx = first + done + i;
+                    if(!firstBad.found || job < firstBad.job || (job == firstBad.job && idx < firstBad.index))
+                        firstBad = { true, job, idx, a, b, want, k.got[i] };
+                    stop.store(true);
+                    break;
+                }
+                pairsDone.fetch_add(n);
+            }
+        }
+        lock_guard<mutex> g(lock);
+        inFlight[id] = UINT64_MAX;
+    }
+};
+
+static void saveCheckpoint(const string& path, const string& config, uint64_t next){
+    if(path.empty()) return;
+    string tmp = path + ".tmp";
+    {
+        ofstream f(tmp);
+        f << "verify-checkpoint 1\n" << config << "\n" << next << "\n";
+    }
+    rename(tmp.c_str(), path.c_str());
+}
+
+static bool loadCheckpoint(const string& path, const string& config, uint64_t& next){
+    ifstream f(path);
+    string magic, cfg;
+    if(!getline(f, magic) || magic != "verify-checkpoint 1" || !getline(f, cfg) || !(f >> next)) return false;
+    if(cfg != config){ fprintf(stderr, "checkpoint %s was written for a different configuration:\n  %s\n", path.c_str(), cfg.c_str()); exit(2); }
+    return true;
+}
+
+static void printOutcome(const char* tag, Op op, const Outcome& o){
+    if(op==OP_ADD || op==OP_SUB) printf("  %s result=0x%08X N=%d Z=%d C=%d V=%d\n", tag, o.lo, o.n, o.z, o.c, o.v);
+    else if(op==OP_DIVU || op==OP_DIVS) printf("  %s q=0x%08X r=0x%08X overflow=%d\n", tag, o.lo, o.hi, o.v);
+    else if(op==OP_SLL || op==OP_SRL || op==OP_SRA) printf("  %s result=0x%08X\n", tag, o.lo);
+    else printf("  %s high=0x%08X low=0x%08X overflow=%d\n", tag, o.hi, o.lo, o.v);
+}
+
+static bool parseU64(const char* s, uint64_t& v){ char* e; v = strtoull(s, &e, 0); return *s && !*e; }
+
+static int usage(){
+    fprintf(stderr, "usage: verify [--units alu,mul,div,shift] [--sweep] [--random N] [--seed S] [--range LO:HI]\n"
+                    "              [--partners V,V,...] [--threads T] [--sliced] [--checkpoint FILE] [--resume]\n");
+    return 2;
+}
+
+int main(int argc, char** argv){
+    Options opt;
+    for(int i=1;i<argc;++i){
+        string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+        uint64_t x = 0;
+        if(arg == "--sweep") opt.sweep = true;
+        else if(arg == "--sliced") opt.sliced = true;
+        else if(arg == "--resume") opt.resume = true;
+        else if(arg == "--random" && (v = next()) && parseU64(v, x)) opt.randomPairs = x;
+        else if(arg == "--seed" && (v = next()) && parseU64(v, x)) opt.seed = x;
+        else if(arg == "--threads" && (v = next()) && parseU64(v, x)) opt.threads = (unsigned)x;
+        else if(arg == "--checkpoint" && (v = next())) opt.checkpoint = v;
+        else if(arg == "--units" && (v = next())){
+            string s = v; for(bool& u : opt.units) u = false;
+            opt.units[0] = s.find("alu") != string::npos; opt.units[1] = s.find("mul") != string::npos; opt.units[2] = s.find("div") != string::npos;
+            opt.units[3] = s.find("shift") != string::npos;
+        }
+        else if(arg == "--partners" && (v = next())){
+            opt.partners.clear();
+            stringstream ss(v); string item;
+            while(getline(ss, item, ',')){ if(!parseU64(item.c_str(), x)) return usage(); opt.partners.push_back((uint32_t)x); }
+        }
+        else if(arg == "--range" && (v = next())){
+            string s = v; size_t c = s.find(':');
+            uint64_t lo, hi;
+            if(c == string::npos || !parseU64(s.substr(0, c).c_str(), lo) || !parseU64(s.substr(c + 1).c_str(), hi) || lo >= hi || hi > (1ull << 32)) return usage();
+            opt.lo = lo; opt.hi = hi;
+        }
+        else return usage();
+    }
+    if(!opt.sweep && !opt.randomPairs) opt.randomPairs = 1000000;   // default: a quick random pass
+    if(!opt.threads) opt.threads = max(1u, thread::hardware_concurrency());
+    if(opt.resume && opt.checkpoint.empty()) return usage();
+
+    Run run(opt);
+    run.plan();
+    uint64_t start = 0;
+    if(opt.resume && loadCheckpoint(opt.checkpoint, run.config, start)) printf("resuming at chunk %llu\n", (unsigned long long)start);
+    run.nextChunk = start;
+    run.inFlight.assign(opt.threads, UINT64_MAX);
+
+    uint64_t totalPairs = 0;
+    for(const Job& j : run.jobs) totalPairs += j.count;
+    uint64_t skipped = 0;
+    for(uint64_t c = 0; c < start; ++c){ size_t j; uint64_t f, n; run.locate(c, j, f, n); skipped += n; }
+    printf("verify: %zu jobs, %llu pairs, %u threads, %s units, MUL engine %s, DIV engine %s, seed %llu\n",
+           run.jobs.size(), (unsigned long long)totalPairs, opt.threads, opt.sliced ? "bit-sliced" : "scalar",
+           MUL_ENGINE::name(), DIV_ENGINE::name(), (unsigned long long)opt.seed);
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for(unsigned t=0;t<opt.threads;++t) pool.emplace_back([&run, t]{ run.worker(t); });
+
+    // progress + checkpoint every few seconds until the workers finish
+    atomic<bool> finished{false};
+    thread reporter([&]{
+        auto last = chrono::steady_clock::now();
+        while(!finished.load()){
+            this_thread::sleep_for(chrono::milliseconds(200));
+            auto now = chrono::steady_clock::now();
+            if(now - last < chrono::seconds(5)) continue;
+            last = now;
+            double secs = chrono::duration<double>(now - t0).count();
+            uint64_t done = run.pairsDone.load();
+            double rate = done / secs;
+            uint64_t left = totalPairs - skipped - (done < totalPairs - skipped ? done : totalPairs - skipped);
+            printf("  %5.1f%%  %.2f Mpairs/s  ETA %.0f s\n", 100.0 * (skipped + done) / (double)totalPairs, rate / 1e6, rate > 0 ? left / rate : 0.0);
+            fflush(stdout);
+            saveCheckpoint(opt.checkpoint, run.config, run.watermark());
+        }
+    });
+    for(thread& t : pool) t.join();
+    finished = true;
+    reporter.join();
+
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if(run.firstBad.found){
+        const Job& j = run.jobs[run.firstBad.job];
+        printf("MISMATCH in %s %s at index %llu (seed %llu)\n", kOpName[j.op], describePairing(j).c_str(),
+               (unsigned long long)run.firstBad.index, (unsigned long long)opt.seed);
+        printf("  a=0x%08X (%d)  b=0x%08X (%d)\n", run.firstBad.a, (int)run.firstBad.a, run.firstBad.b, (int)run.firstBad.b);
+        printOutcome("want", j.op, run.firstBad.want);
+        printOutcome("got ", j.op, run.firstBad.got);
+        saveCheckpoint(opt.checkpoint, run.config, run.watermark());
+        return 1;
+    }
+    saveCheckpoint(opt.checkpoint, run.config, run.totalChunks);
+    printf("all %llu pairs passed in %.1f s (%.2f Mpairs/s)\n", (unsigned long long)(totalPairs - skipped), secs,
+           (totalPairs - skipped) / secs / 1e6);
+    return 0;
+}
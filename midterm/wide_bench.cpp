@@ -0,0 +1,182 @@
+// wide_bench.cpp - the width-templated units: cross-checks, then speed per width and engine
+// Build: g++ -O2 -std=c++17 wide_bench.cpp -o wide_bench
+//        (-DWIDE_ADDER=... / -DMUL_ENGINE=... / -DKARATSUBA_MIN_BITS=... / -DNEWTON_MIN_BITS=...)
+// Usage: wide_bench [operations]
+// Checks: at 32 bits every wide unit against the 32-bit units; at 64 bits against host 128-bit
+// arithmetic; at every width 32-bit operands (zero- or sign-extended) against the 32-bit units,
+// Karatsuba against schoolbook and Newton against restoring on full-width operands.
+// Exit code: 0 all passed, 1 mismatch.
+#include "wide_ops.h"
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static uint64_t rngState = 88172645463325252ull;
+static uint64_t rnd64(){ rngState^=rngState<<13; rngState^=rngState>>7; rngState^=rngState<<17; return rngState; }
+
+static double nowNs(){ return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+static long failures = 0;
+static void check(bool ok, const char* what, int width){
+    if(!ok && failures++ < 10) printf("MISMATCH %s at %d bits\n", what, width);
+}
+
+// full-width random values, some cut short (divisors of every length) and the edge values
+template <int N>
+static Bits<N> wideValue(size_t i){
+    Bits<N> x;
+    for(int j=0;j<Bits<N>::W;++j) x.w[j] = rnd64();
+    trimTop(x);
+    switch(i % 8){
+        case 1: wireShiftDown(x,(int)(rnd64() % N),x); break;
+        case 2: x = i % 16 < 8 ? zeros<N>() : ones<N>(); break;
+        case 3: if(i % 16 < 8){ x = zeros<N>(); x.set(0,1); } else { x = ones<N>(); x.set(0,0); } break;
+        case 4: x = intToBits<N>((long long)(rnd64() % 5) - 2); break;
+    }
+    return x;
+}
+
+static const long long kEdge32[] = { 0, 1, -1, 2, -2, INT_MIN, INT_MAX, INT_MIN + 1 };
+static long long value32(size_t i){ return i % 4 == 0 ? kEdge32[rnd64() % 8] : (long long)(int)rnd64(); }
+
+// ---- 32 bits: every wide unit against the 32-bit units ----
+static void check32(size_t n){
+    for(size_t i=0;i<n;++i){
+        Bits<32> a = intToBits(value32(i)), b = intToBits(value32(i + 1));
+        for(int sub=0;sub<2;++sub){
+            ALUResult r; ALUResultW<32> w; ALU(a,b,sub,r); aluW(a,b,sub,w);
+            check(sameBits(r.result,w.result) && r.flags.N==w.flags.N && r.flags.Z==w.flags.Z &&
+                  r.flags.C==w.flags.C && r.flags.V==w.flags.V, sub ? "sub" : "add", 32);
+        }
+        MulOut m; MulOutW<32> mw;
+        mul_ss(a,b,m,false); mulW_ss(a,b,mw);
+        check(sameBits(m.low32,mw.low) && sameBits(m.high32,mw.high) && m.overflow==mw.overflow, "mul_ss", 32);
+        mul_su(a,b,m,false); mulW_su(a,b,mw);
+        check(sameBits(m.low32,mw.low) && sameBits(m.high32,mw.high), "mul_su", 32);
+        mul_uu(a,b,m,false); mulW_uu(a,b,mw);
+        check(sameBits(m.low32,mw.low) && sameBits(m.high32,mw.high), "mul_uu", 32);
+        DivOut d; DivOutW<32> dw; DivPair s;
+        divu(a,b,d,false); divuW(a,b,dw);
+        check(sameBits(d.q,dw.q) && sameBits(d.r,dw.r), "divu", 32);
+        div_signed(a,b,s,false); divSignedW(a,b,dw);
+        check(sameBits(s.q,dw.q) && sameBits(s.r,dw.r) && s.overflow==dw.overflow, "div", 32);
+    }
+}
+
+// ---- 64 bits (RV64): against host 128-bit arithmetic ----
+static void check64(size_t n){
+    typedef unsigned __int128 u128;
+    for(size_t i=0;i<n;++i){
+        Bits<64> a = wideValue<64>(i), b = wideValue<64>(i * 7 + 3);
+        uint64_t ua = a.w[0], ub = b.w[0];
+        int64_t sa = (int64_t)ua, sb = (int64_t)ub;
+        for(int sub=0;sub<2;++sub){
+            ALUResultW<64> w; aluW(a,b,sub,w);
+            uint64_t want = sub ? ua - ub : ua + ub;
+            int c = sub ? (ub == 0 ? 0 : ua >= ub) : want < ua;
+            int v = sub ? ((sa < 0) != (sb < 0) && ((int64_t)want < 0) != (sa < 0)) : ((sa < 0) == (sb < 0) && ((int64_t)want < 0) != (sa < 0));
+            check(w.result.w[0]==want && w.flags.N==(int)(want >> 63) && w.flags.Z==(want == 0) && w.flags.C==c && w.flags.V==v,
+                  sub ? "sub" : "add", 64);
+        }
+        MulOutW<64> m;
+        u128 pu = (u128)ua * ub; __int128 ps = (__int128)sa * sb, pm = (__int128)sa * (__int128)(u128)ub;
+        mulW_uu(a,b,m); check(m.low.w[0]==(uint64_t)pu && m.high.w[0]==(uint64_t)(pu >> 64), "mul_uu", 64);
+        mulW_ss(a,b,m); check(m.low.w[0]==(uint64_t)ps && m.high.w[0]==(uint64_t)((u128)ps >> 64) &&
+                              m.overflow==(ps != (__int128)(int64_t)(uint64_t)ps), "mul_ss", 64);
+        mulW_su(a,b,m); check(m.low.w[0]==(uint64_t)pm && m.high.w[0]==(uint64_t)((u128)pm >> 64), "mul_su", 64);
+        DivOutW<64> d;
+        divuW(a,b,d);
+        check(ub ? d.q.w[0]==ua / ub && d.r.w[0]==ua % ub : d.q.w[0]==~0ull && d.r.w[0]==ua, "divu", 64);
+        divSignedW(a,b,d);
+        int64_t q = !sb ? -1 : (sa == LLONG_MIN && sb == -1) ? LLONG_MIN : sa / sb;
+        int64_t r = !sb ? sa : (sa == LLONG_MIN && sb == -1) ? 0 : sa % sb;
+        check((int64_t)d.q.w[0]==q && (int64_t)d.r.w[0]==r && d.overflow==(sa == LLONG_MIN && sb == -1), "div", 64);
+        if(ub){ Bits<64> nq, nr; divNewtonW(a,b,nq,nr); check(nq.w[0]==ua / ub && nr.w[0]==ua % ub, "divu newton", 64); }
+    }
+}
+
+// ---- every width: 32-bit operands against the 32-bit units, engines against each other ----
+template <int N>
+static void checkWide(size_t n){
+    for(size_t i=0;i<n;++i){
+        long long x = value32(i), y = value32(i + 1);
+        Bits<32> a32 = intToBits(x), b32 = intToBits(y);
+        Bits<N> za, zb, sa, sb;
+        zeroExtend(a32,za); zeroExtend(b32,zb); signExtendTo(a32,sa); signExtendTo(b32,sb);
+
+        MulOut m; MulOutW<N> mw; Bits<64> p; Bits<2*N> wide, want;
+        mul_uu(a32,b32,m,false); mulW_uu(za,zb,mw);
+        placeBits(m.low32,0,p); placeBits(m.high32,32,p); zeroExtend(p,want);
+        placeBits(mw.low,0,wide); placeBits(mw.high,N,wide);
+        check(sameBits(wide,want), "mul_uu (32-bit operands)", N);
+        mul_ss(a32,b32,m,false); mulW_ss(sa,sb,mw);
+        placeBits(m.low32,0,p); placeBits(m.high32,32,p); signExtendTo(p,want);
+        placeBits(mw.low,0,wide); placeBits(mw.high,N,wide);
+        check(sameBits(wide,want) && !mw.overflow, "mul_ss (32-bit operands)", N);
+
+        DivOut d; DivOutW<N> dw; Bits<N> wq, wr;
+        divu(a32,b32,d,false); divuW(za,zb,dw);
+        if(y){ zeroExtend(d.q,wq); zeroExtend(d.r,wr); } else { wq = ones<N>(); zeroExtend(a32,wr); }
+        check(sameBits(dw.q,wq) && sameBits(dw.r,wr), "divu (32-bit operands)", N);
+        if(!(x == INT_MIN && y == -1)){              // only 32 bits overflow there
+            DivPair s; div_signed(a32,b32,s,false); divSignedW(sa,sb,dw);
+            signExtendTo(s.q,wq); signExtendTo(s.r,wr);
+            check(sameBits(dw.q,wq) && sameBits(dw.r,wr), "div (32-bit operands)", N);
+        }
+
+        Bits<N> a = wideValue<N>(i), b = wideValue<N>(i * 7 + 3);
+        Bits<2*N> ps, pk;
+        mulSchoolbook(a,b,ps); mulKaratsuba<N,64>(a,b,pk);
+        check(sameBits(ps,pk), "karatsuba vs schoolbook", N);
+        if(!isZeroBits(b)){
+            Bits<N> q1, r1, q2, r2;
+            divRestoringW(a,b,q1,r1); divNewtonW(a,b,q2,r2);
+            check(sameBits(q1,q2) && sameBits(r1,r2), "newton vs restoring", N);
+        }
+    }
+}
+
+// ---- speed: microseconds per operation ----
+template <class F>
+static double timeUs(size_t n, F f){
+    double t0 = nowNs();
+    for(size_t i=0;i<n;++i) f(i);
+    return (nowNs() - t0) / 1000.0 / (double)n;
+}
+
+template <int N>
+static void speedRow(size_t n){
+    vector<Bits<N>> a(n), b(n);
+    for(size_t i=0;i<n;++i){ a[i] = wideValue<N>(i * 8); b[i] = wideValue<N>(i * 8); wireShiftDown(b[i],(int)(rnd64() % N),b[i]); if(isZeroBits(b[i])) b[i].put(0,1); }
+    Bits<2*N> p; Bits<N> q, r;
+    double sb  = timeUs(n, [&](size_t i){ mulSchoolbook(a[i],b[i],p); });
+    double k64 = timeUs(n, [&](size_t i){ mulKaratsuba<N,64>(a[i],b[i],p); });
+    double k128 = timeUs(n, [&](size_t i){ mulKaratsuba<N,128>(a[i],b[i],p); });
+    double k256 = timeUs(n, [&](size_t i){ mulKaratsuba<N,256>(a[i],b[i],p); });
+    double rs  = timeUs(n, [&](size_t i){ divRestoringW(a[i],b[i],q,r); });
+    double nw  = timeUs(n, [&](size_t i){ divNewtonW(a[i],b[i],q,r); });
+    ALUResultW<N> o;
+    double add = timeUs(n, [&](size_t i){ aluW(a[i],b[i],false,o); a[i].w[0] ^= o.result.w[0] & 1; });
+    printf("%5d %9.2f | %10.1f %10.1f %10.1f %10.1f | %10.1f %10.1f\n", N, add, sb, k64, k128, k256, rs, nw);
+}
+
+int main(int argc, char** argv){
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000;
+    if(n < 8) n = 8;
+
+    printf("wide units: adder %s, limb MUL %s, Karatsuba above %d bits, Newton from %d bits\n\n",
+           WIDE_ADDER::name(), MUL_ENGINE::name(), KARATSUBA_MIN_BITS, NEWTON_MIN_BITS);
+    double t0 = nowNs();
+    check32(n * 10);
+    check64(n * 10);
+    checkWide<64>(n); checkWide<128>(n); checkWide<256>(n / 2); checkWide<512>(n / 4); checkWide<1024>(n / 8);
+    printf("cross-checks: %s (%.1f s)\n\n", failures ? "MISMATCH" : "ok", (nowNs() - t0) / 1e9);
+
+    printf("microseconds per operation (Karatsuba columns: recursion stops at that many bits)\n");
+    printf("%5s %9s | %10s %10s %10s %10s | %10s %10s\n", "bits", "add", "schoolbook", "kara 64", "kara 128", "kara 256", "restoring", "newton");
+    speedRow<64>(n); speedRow<128>(n); speedRow<256>(n / 2); speedRow<512>(n / 4); speedRow<1024>(n / 8);
+    return failures ? 1 : 0;
+}
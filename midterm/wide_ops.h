@@ -0,0 +1,291 @@
+// wide_ops.h - width-templated ALU, MUL and DIV: RV64 and multiprecision (128..1024+ bit) operands
+// The 32-bit units in numeric_ops.h stay the reference; wide_bench.cpp cross-checks these against
+// them where the widths overlap. Widths are multiples of 32: a 32-bit limb is the unit of
+// multiplication and every limb product goes through MUL_ENGINE. Above KARATSUBA_MIN_BITS
+// products split Karatsuba-style; from NEWTON_MIN_BITS division multiplies by a Newton reciprocal,
+// so both scale below N^2 limb operations.
+#pragma once
+
+#include "numeric_ops.h"
+
+// ---- adder for the wide units (compile-time; any adder from adders.h) ----
+// A prefix network keeps a 1024-bit carry chain to log2 N steps; the ripple settle loop walks
+// long carry chains (negation, +1) one wire per pass, and CarryLookahead's group ripple takes
+// N/4 steps.
+#ifndef WIDE_ADDER
+#define WIDE_ADDER KoggeStone
+#endif
+// products wider than this split into three half-width products (bits; tuned by wide_bench)
+#ifndef KARATSUBA_MIN_BITS
+#define KARATSUBA_MIN_BITS 128
+#endif
+// division at this width and wider uses the Newton reciprocal (bits; tuned by wide_bench:
+// restoring and Newton tie at 512 bits, Newton is 10-30% faster at 1024)
+#ifndef NEWTON_MIN_BITS
+#define NEWTON_MIN_BITS 1024
+#endif
+
+// ============================= Section 1: Core Implementation (NO built-in + - * / % << >> on numeric types) =============================
+
+// ---------------- ALU (ADD/SUB) with flags ----------------
+template <int N> struct ALUResultW { Bits<N> result; ALUFlags flags; };
+
+template <int N>
+inline void aluW(const Bits<N>& a, const Bits<N>& b, bool subtract, ALUResultW<N>& out){
+    Bits<N> opB;
+    if(subtract) negateTwos<WIDE_ADDER>(b,opB); else opB=b;
+    int carryOut=0; Bits<N> sum; WIDE_ADDER::add(a,opB,sum,carryOut);
+    int sa=a[0], sb=b[0], sr=sum[0];
+    int overflow = (!subtract)? ((sa==sb) && (sr!=sa)) : ((sa!=sb) && (sr!=sa));
+    out.result = sum;
+    out.flags = ALUFlags{ sr, isZeroBits(sum), carryOut, overflow };
+}
+
+// ---------------- MUL family ----------------
+template <int N> struct MulOutW { Bits<N> low; Bits<N> high; int overflow; };
+
+// one unsigned 32x32 -> 64 limb product through the configured MUL engine
+inline void limbMul(const Bits<32>& a, const Bits<32>& b, Bits<64>& p){ MUL_ENGINE::multiply(a,0,b,0,p,false); }
+
+// Schoolbook: one row a * b_j per limb of b. A row's limb products at even and at odd limbs
+// don't overlap, so each half is wiring and the row is one add. The row lands in the window
+// of wires 32j..32j+N+31 of the accumulator, and nothing carries out of that window.
+template <int N>
+inline void mulSchoolbook(const Bits<N>& a, const Bits<N>& b, Bits<2*N>& prod){
+    static_assert(N % 32 == 0, "wide units work on whole 32-bit limbs");
+    constexpr int L = N / 32;
+    Bits<2*N> acc;
+    for(int j=0;j<L;++j){
+        Bits<32> bj = busLimb(b,j);
+        if(isZeroBits(bj)) continue;
+        Bits<N+32> even, odd, row, win; int c=0;
+        for(int i=0;i<L;++i){ Bits<64> p; limbMul(busLimb(a,i),bj,p); placeLimbs(i%2 ? odd : even, i, p); }
+        WIDE_ADDER::add(even,odd,row,c);
+        takeBits(acc,32*j,win);
+        WIDE_ADDER::add(win,row,win,c);
+        placeBits(win,32*j,acc);
+    }
+    prod = acc;
+}
+
+// Karatsuba: a*b = z2*2^N + ((a0+a1)(b0+b1) - z0 - z2)*2^H + z0 with z0 = a0*b0, z2 = a1*b1.
+// The half sums keep their carry wires, folded back in as shifted copies of the other sum.
+template <int N, int MinBits = KARATSUBA_MIN_BITS>
+inline void mulKaratsuba(const Bits<N>& a, const Bits<N>& b, Bits<2*N>& prod){
+    if constexpr (N <= MinBits || N % 64 != 0) mulSchoolbook(a,b,prod);
+    else {
+        constexpr int H = N / 2;
+        Bits<H> a0, a1, b0, b1, sa, sb;
+        takeBits(a,0,a0); takeBits(a,H,a1); takeBits(b,0,b0); takeBits(b,H,b1);
+        Bits<N> z0, z2, m;
+        mulKaratsuba<H,MinBits>(a0,b0,z0);
+        mulKaratsuba<H,MinBits>(a1,b1,z2);
+        int ca=0, cb=0, c=0;
+        WIDE_ADDER::add(a0,a1,sa,ca); WIDE_ADDER::add(b0,b1,sb,cb);
+        mulKaratsuba<H,MinBits>(sa,sb,m);
+
+        // (ca*2^H + sa)(cb*2^H + sb) on N+2 wires, then minus z0 and z2
+        Bits<N+2> mid, t;
+        resizeBits(m,mid);
+        if(ca){ resizeBits(sb,t); wireShiftUp(t,H,t); WIDE_ADDER::add(mid,t,mid,c); }
+        if(cb){ resizeBits(sa,t); wireShiftUp(t,H,t); WIDE_ADDER::add(mid,t,mid,c); }
+        if(ca & cb){ t = zeros<N+2>(); t.put(N,1); WIDE_ADDER::add(mid,t,mid,c); }
+        resizeBits(z0,t); uSub<WIDE_ADDER>(mid,t,mid,c);
+        resizeBits(z2,t); uSub<WIDE_ADDER>(mid,t,mid,c);
+
+        // z2:z0 side by side is wiring; the middle term is added in at wire H
+        Bits<2*N> r; Bits<N+H> win, m2;
+        placeBits(z0,0,r); placeBits(z2,N,r);
+        takeBits(r,H,win); resizeBits(mid,m2);
+        WIDE_ADDER::add(win,m2,win,c);
+        placeBits(win,H,r);
+        prod = r;
+    }
+}
+
+template <int N>
+inline void mulWide(const Bits<N>& a, const Bits<N>& b, Bits<2*N>& prod){ mulKaratsuba(a,b,prod); }
+
+// magnitudes through the unsigned product, sign fixed up afterwards (ShiftAddMul's scheme)
+template <int N>
+inline void mulW(const Bits<N>& a, int aSigned, const Bits<N>& b, int bSigned, MulOutW<N>& out){
+    Bits<N> aa, bb;
+    if(aSigned) absSigned<WIDE_ADDER>(a,aa); else aa=a;
+    if(bSigned) absSigned<WIDE_ADDER>(b,bb); else bb=b;
+    int neg = (aSigned & signBit(a)) ^ (bSigned & signBit(b));
+    Bits<2*N> prod; mulWide(aa,bb,prod);
+    if(neg && !isZeroBits(prod)) negateTwos<WIDE_ADDER>(prod,prod);
+    takeBits(prod,N,out.high); takeBits(prod,0,out.low);
+    out.overflow = 0;
+    if(aSigned & bSigned){ Bits<2*N> se; signExtendTo(out.low,se); out.overflow = sameBits(se,prod) ? 0 : 1; }
+}
+
+template <int N> inline void mulW_ss(const Bits<N>& a, const Bits<N>& b, MulOutW<N>& out){ mulW(a,1,b,1,out); }
+template <int N> inline void mulW_su(const Bits<N>& a, const Bits<N>& b, MulOutW<N>& out){ mulW(a,1,b,0,out); }
+template <int N> inline void mulW_uu(const Bits<N>& a, const Bits<N>& b, MulOutW<N>& out){ mulW(a,0,b,0,out); }
+
+// ---------------- DIV/REM family ----------------
+template <int N> struct DivOutW { Bits<N> q; Bits<N> r; int overflow; };
+
+// Restoring: N trial subtracts, each kept or dropped (RestoringDiv at any width)
+template <int N>
+inline void divRestoringW(const Bits<N>& dividend, const Bits<N>& divisor, Bits<N>& q, Bits<N>& r){
+    Bits<N> R, Q, RminusD, negD;
+    negateTwos<WIDE_ADDER>(divisor,negD);
+    for(int i=0;i<N;++i){
+        shiftLeft1(R,R); R.put(0,dividend[i]);
+        int noBorrow=0; WIDE_ADDER::add(R,negD,RminusD,noBorrow);
+        if(noBorrow) R = RminusD;
+        shiftLeft1(Q,Q); Q.put(0,noBorrow);
+    }
+    q = Q; r = R;
+}
+
+// leading zero wires of a nonzero bus: the normalize shifter's select (control only)
+template <int N>
+inline int leadingZerosW(const Bits<N>& x){ int p=N-1; while(p>0 && !x.get(p)) --p; return N-1-p; }
+
+// 2^2W - 1 - D*(2^W + v), two's complement on 2W+2 wires
+template <int W>
+inline void reciprocalResidual(const Bits<W>& D, const Bits<W>& v, Bits<2*W+2>& e){
+    Bits<2*W> dv; mulWide(D,v,dv);
+    Bits<2*W+2> t, dy; int c=0;
+    resizeBits(dv,dy); resizeBits(D,t); wireShiftUp(t,W,t);
+    WIDE_ADDER::add(dy,t,dy,c);
+    resizeBits(ones<2*W>(),e);
+    uSub<WIDE_ADDER>(e,dy,e,c);
+}
+
+// Reciprocal of a normalized D (top wire set): v = floor((2^2W - 1) / D) - 2^W, i.e. the
+// quotient with its implicit leading one dropped, exact at every width. Precision doubles per
+// level: the half-width reciprocal of D's top half is good to about W/2 wires, one Newton step
+// Y += Y * e / 2^2W (e the residual above) brings that to within a few units, and a short
+// correction walk makes it exact again, so errors never compound from level to level.
+template <int W>
+inline void reciprocalW(const Bits<W>& D, Bits<W>& v){
+    if constexpr (W <= 32 || W % 64 != 0) {
+        Bits<2*W> den, q, r;
+        resizeBits(D,den);
+        divRestoringW(ones<2*W>(),den,q,r);
+        takeBits(q,0,v);
+    } else {
+        constexpr int H = W / 2;
+        Bits<H> dh, vh; takeBits(D,H,dh);
+        reciprocalW(dh,vh);
+        resizeBits(vh,v); wireShiftUp(v,H,v);
+
+        // Newton step Y += Y * e / 2^2W. |e| < 2^(W+H+2), so e / 2^(W+2) and v / 2^H are
+        // H-wire values and one half-width product gives the step, a few units short at most.
+        Bits<2*W+2> e, ae; reciprocalResidual(D,v,e);
+        int neg = e[0];
+        if(neg) negateTwos<WIDE_ADDER>(e,ae); else ae = e;
+        Bits<H> eh, vh2, hi, sum; takeBits(ae,W+2,eh); takeBits(v,H,vh2);
+        Bits<W> ev, step; mulWide(eh,vh2,ev); takeBits(ev,H,hi);
+        int c=0; WIDE_ADDER::add(eh,hi,sum,c);
+        resizeBits(sum,step); step.put(H,c); wireShiftUp(step,2,step);
+
+        // the residual moves by D * step; the step spans about half the limbs, which the
+        // schoolbook rows skip
+        Bits<2*W> ds; mulSchoolbook(D,step,ds);
+        Bits<2*W+2> dse; resizeBits(ds,dse);
+        int clamped;
+        if(neg){ uSub<WIDE_ADDER>(v,step,v,c); clamped = !c; WIDE_ADDER::add(e,dse,e,c); }
+        else   { WIDE_ADDER::add(v,step,v,c);  clamped = c;  uSub<WIDE_ADDER>(e,dse,e,c); }
+        if(clamped){ v = neg ? zeros<W>() : ones<W>(); reciprocalResidual(D,v,e); }
+
+        // walk to 0 <= e < D
+        Bits<2*W+2> d2; resizeBits(D,d2);
+        Bits<W> one; one.put(0,1);
+        while(e[0]){ WIDE_ADDER::add(e,d2,e,c); uSub<WIDE_ADDER>(v,one,v,c); }
+        for(;;){
+            Bits<2*W+2> t; int noBorrow=0; uSub<WIDE_ADDER>(e,d2,t,noBorrow);
+            if(!noBorrow) break;
+            e = t; WIDE_ADDER::add(v,one,v,c);
+        }
+    }
+}
+
+// One H-wire quotient digit of U / D (H = N/2, D normalized, U < D * 2^H). With 2^H + vh the
+// reciprocal of D's top digit, u2 + (u2 * vh + u1) / 2^H is Knuth's two-digit estimate taken
+// through a multiply, within a few of the digit either way; the remainder U - digit * D is
+// then walked into [0, D) one add of D at a time.
+template <int N>
+inline void divDigit(const Bits<N+N/2>& U, const Bits<N>& D, const Bits<N/2>& vh, Bits<N/2>& digit, Bits<N>& rem){
+    constexpr int H = N / 2;
+    Bits<H> u2, u1, d1, d0, qd, one; one.put(0,1);
+    takeBits(U,N,u2); takeBits(U,H,u1); takeBits(D,H,d1); takeBits(D,0,d0);
+    Bits<N> p; mulWide(u2,vh,p);
+    Bits<N+1> e, t; int c=0;
+    resizeBits(p,e); resizeBits(u1,t); WIDE_ADDER::add(e,t,e,c);
+    Bits<H+1> qh, u2w; takeBits(e,H,qh); resizeBits(u2,u2w); WIDE_ADDER::add(qh,u2w,qh,c);
+    if(qh[0]) qd = ones<H>(); else takeBits(qh,0,qd);        // the digit is below 2^H
+
+    // U - digit * D, two's complement on N+H+1 wires
+    Bits<N> t0, t1; mulWide(qd,d0,t0); mulWide(qd,d1,t1);
+    Bits<N+H+1> R, T, x, Dw;
+    resizeBits(t0,T); resizeBits(t1,x); wireShiftUp(x,H,x); WIDE_ADDER::add(T,x,T,c);
+    resizeBits(U,R); uSub<WIDE_ADDER>(R,T,R,c);
+    resizeBits(D,Dw);
+    while(R[0]){ WIDE_ADDER::add(R,Dw,R,c); uSub<WIDE_ADDER>(qd,one,qd,c); }
+    for(;;){
+        Bits<N+H+1> t2; int noBorrow=0; uSub<WIDE_ADDER>(R,Dw,t2,noBorrow);
+        if(!noBorrow) break;
+        R = t2; WIDE_ADDER::add(qd,one,qd,c);
+    }
+    digit = qd; takeBits(R,0,rem);
+}
+
+// Newton division: d shifted up s wires to D (top wire set), a shifted with it, then long
+// division in two H-wire digits, both estimated through the one Newton reciprocal of D's top
+// digit. Six half-width products and a half-width reciprocal against N full-width trial
+// subtracts for restoring. Widths that don't split into whole limbs divide by restoring.
+template <int N>
+inline void divNewtonW(const Bits<N>& a, const Bits<N>& d, Bits<N>& q, Bits<N>& r){
+    if constexpr (N <= 32 || N % 64 != 0) divRestoringW(a,d,q,r);
+    else {
+        constexpr int H = N / 2;
+        int s = leadingZerosW(d);
+        Bits<N> D, rem; wireShiftUp(d,s,D);
+        Bits<2*N> A; resizeBits(a,A); wireShiftUp(A,s,A);
+        Bits<H> d1, vh, q1, q0, a0;
+        takeBits(D,H,d1); reciprocalW(d1,vh);
+
+        Bits<N+H> U; takeBits(A,H,U);                       // a / d < 2^N, so U < D * 2^H
+        divDigit(U,D,vh,q1,rem);
+        takeBits(A,0,a0);
+        resizeBits(rem,U); wireShiftUp(U,H,U); placeBits(a0,0,U);
+        divDigit(U,D,vh,q0,rem);
+
+        q = zeros<N>(); placeBits(q0,0,q); placeBits(q1,H,q);
+        wireShiftDown(rem,s,r);
+    }
+}
+
+// unsigned divide for a nonzero divisor through the engine for this width
+template <int N>
+inline void divuCoreW(const Bits<N>& a, const Bits<N>& d, Bits<N>& q, Bits<N>& r){
+    if constexpr (N >= NEWTON_MIN_BITS) divNewtonW(a,d,q,r); else divRestoringW(a,d,q,r);
+}
+
+// RISC-V DIVU/REMU at width N: x / 0 = all ones, x % 0 = x
+template <int N>
+inline void divuW(const Bits<N>& dividend, const Bits<N>& divisor, DivOutW<N>& out){
+    out.overflow = 0;
+    if(isZeroBits(divisor)){ out.q = ones<N>(); out.r = dividend; return; }
+    divuCoreW(dividend,divisor,out.q,out.r);
+}
+
+// RISC-V DIV/REM at width N: x / 0 = -1, x % 0 = x, MIN / -1 = MIN rem 0 (flagged)
+template <int N>
+inline void divSignedW(const Bits<N>& A, const Bits<N>& B, DivOutW<N>& out){
+    out.overflow = 0;
+    if(isZeroBits(B)){ out.q = ones<N>(); out.r = A; return; }
+    Bits<N> intMin; intMin.set(0,1);
+    if(sameBits(A,intMin) && sameBits(B,ones<N>())){ out.q = intMin; out.r = zeros<N>(); out.overflow = 1; return; }
+
+    int sA=signBit(A), sB=signBit(B);
+    Bits<N> ua, ub; absSigned<WIDE_ADDER>(A,ua); absSigned<WIDE_ADDER>(B,ub);
+    divuCoreW(ua,ub,out.q,out.r);
+    if(sA ^ sB) negateTwos<WIDE_ADDER>(out.q,out.q);   // quotient truncates toward zero
+    if(sA)      negateTwos<WIDE_ADDER>(out.r,out.r);   // remainder sign follows dividend
+}